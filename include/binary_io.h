@@ -0,0 +1,54 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+
+// Lecture / écriture binaire brute (ordre d'octets de la machine) pour les fichiers
+// produits et relus par le simulateur lui-même : hiérarchie de contraction, checkpoints...
+
+template <typename T>
+void writePod(std::ostream& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "writePod: type non trivial");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::istream& in, T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "readPod: type non trivial");
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// Tableau préfixé par sa taille (uint64)
+template <typename T>
+void writeVector(std::ostream& out, const std::vector<T>& values) {
+    writePod(out, uint64_t(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()), std::streamsize(values.size() * sizeof(T)));
+}
+
+// maxSize protège contre un fichier corrompu annonçant une taille absurde
+template <typename T>
+bool readVector(std::istream& in, std::vector<T>& values, uint64_t maxSize) {
+    uint64_t size = 0;
+    if (!readPod(in, size) || size > maxSize) return false;
+    values.resize(size_t(size));
+    return bool(in.read(reinterpret_cast<char*>(values.data()), std::streamsize(size * sizeof(T))));
+}
+
+inline void writeString(std::ostream& out, const std::string& s) {
+    writePod(out, uint64_t(s.size()));
+    out.write(s.data(), std::streamsize(s.size()));
+}
+
+inline bool readString(std::istream& in, std::string& s, uint64_t maxSize) {
+    uint64_t size = 0;
+    if (!readPod(in, size) || size > maxSize) return false;
+    s.resize(size_t(size));
+    return bool(in.read(&s[0], std::streamsize(size)));
+}
+
+#endif // BINARY_IO_H
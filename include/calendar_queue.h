@@ -0,0 +1,106 @@
+#ifndef CALENDAR_QUEUE_H
+#define CALENDAR_QUEUE_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief File d'événements « calendrier » (seaux de largeur fixe)
+ *
+ * Le temps est découpé en seaux de largeur bucketWidth ; une fenêtre de
+ * bucketCount seaux couvre le futur proche, le reste attend dans un tas
+ * (overflow) et rejoint les seaux quand la fenêtre avance. Insertion en O(1),
+ * extraction en O(taille du seau) : adapté à des millions d'événements
+ * proches dans le temps (slots radio, fins de trame).
+ *
+ * Event doit exposer time (double) et seq (numéro d'ordre, départage les
+ * égalités pour un ordre déterministe). Un événement dans le passé est
+ * traité comme appartenant au seau courant.
+ */
+template <typename Event>
+class CalendarQueue {
+public:
+    explicit CalendarQueue(double bucketWidth = 1e-4, size_t bucketCount = 1024)
+        : m_width(bucketWidth), m_buckets(bucketCount) {}
+
+    void push(const Event& e) {
+        ++m_size;
+        const double offset = (e.time - m_windowStart) / m_width;
+        if (offset >= double(m_buckets.size())) {
+            m_overflow.push_back(e);
+            std::push_heap(m_overflow.begin(), m_overflow.end(), later);
+            return;
+        }
+        size_t b = offset > 0.0 ? size_t(offset) : 0;
+        if (b < m_cursor) b = m_cursor;
+        m_buckets[b].push_back(e);
+    }
+
+    // Extrait l'événement le plus ancien ; false si la file est vide
+    bool pop(Event& out) {
+        if (m_size == 0) return false;
+
+        for (;;) {
+            for (; m_cursor < m_buckets.size(); ++m_cursor) {
+                std::vector<Event>& bucket = m_buckets[m_cursor];
+                if (bucket.empty()) continue;
+
+                size_t best = 0;
+                for (size_t i = 1; i < bucket.size(); ++i) {
+                    if (later(bucket[best], bucket[i])) best = i;
+                }
+                out = bucket[best];
+                bucket[best] = bucket.back();
+                bucket.pop_back();
+                --m_size;
+                return true;
+            }
+            advanceWindow();
+        }
+    }
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    void clear() {
+        for (auto& bucket : m_buckets) bucket.clear();
+        m_overflow.clear();
+        m_windowStart = 0.0;
+        m_cursor = 0;
+        m_size = 0;
+    }
+
+private:
+    static bool later(const Event& a, const Event& b) {
+        return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+    }
+
+    // Fenêtre épuisée : passer à la suivante (ou sauter directement au prochain événement)
+    void advanceWindow() {
+        const double span = m_width * double(m_buckets.size());
+        m_windowStart += span;
+        m_cursor = 0;
+        if (!m_overflow.empty() && m_overflow.front().time >= m_windowStart + span) {
+            m_windowStart = std::floor(m_overflow.front().time / m_width) * m_width;
+        }
+
+        while (!m_overflow.empty() && m_overflow.front().time < m_windowStart + span) {
+            std::pop_heap(m_overflow.begin(), m_overflow.end(), later);
+            const Event e = m_overflow.back();
+            m_overflow.pop_back();
+            const double offset = (e.time - m_windowStart) / m_width;
+            m_buckets[offset > 0.0 ? std::min(size_t(offset), m_buckets.size() - 1) : 0].push_back(e);
+        }
+    }
+
+    double m_width;
+    std::vector<std::vector<Event>> m_buckets;
+    std::vector<Event> m_overflow;      // tas min (sur time, seq) au-delà de la fenêtre
+    double m_windowStart = 0.0;
+    size_t m_cursor = 0;                // premier seau non épuisé de la fenêtre
+    size_t m_size = 0;
+};
+
+#endif // CALENDAR_QUEUE_H
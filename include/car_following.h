@@ -0,0 +1,43 @@
+#ifndef CAR_FOLLOWING_H
+#define CAR_FOLLOWING_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Paramètres de l'Intelligent Driver Model (Treiber et al.)
+ */
+struct IdmParams {
+    double maxAccel = 1.0;        // a  : accélération maximale (m/s²)
+    double comfortDecel = 1.5;    // b  : décélération confortable (m/s²)
+    double timeHeadway = 1.5;     // T  : temps inter-véhiculaire désiré (s)
+    double minGap = 2.0;          // s0 : distance minimale à l'arrêt (m)
+    double vehicleLength = 4.5;   // l  : longueur d'un véhicule (m)
+};
+
+/**
+ * @brief Données de l'IDM au format tableaux (une case par véhicule)
+ *
+ * Le simulateur remplit speed / desiredSpeed / gap / leaderSpeed, puis
+ * computeAccelerations calcule accel en une seule boucle arithmétique sans
+ * branchement ni appel de fonction (vectorisable par le compilateur).
+ * gap vaut +infini quand il n'y a pas de véhicule devant.
+ */
+struct IdmState {
+    std::vector<double> speed;
+    std::vector<double> desiredSpeed;
+    std::vector<double> gap;          // distance pare-choc à pare-choc (m)
+    std::vector<double> leaderSpeed;
+    std::vector<double> accel;
+
+    void resize(size_t n);
+};
+
+/**
+ * @brief Accélération IDM de chaque véhicule (exposant delta = 4)
+ *
+ * acc = a * (1 - (v/v0)^4 - (s_star/s)^2),  s_star = s0 + max(0, v*T + v*dv / (2*sqrt(a*b)))
+ */
+void computeAccelerations(const IdmParams& params, IdmState& state);
+
+#endif // CAR_FOLLOWING_H
@@ -0,0 +1,114 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "graph_types.h"
+
+/**
+ * @brief Hiérarchie de contraction (CH) sur le réseau routier
+ *
+ * Prétraitement hors ligne : les sommets sont contractés un à un (ordre par
+ * différence d'arêtes, mise à jour paresseuse) et des raccourcis sont ajoutés
+ * lorsqu'aucun chemin témoin n'existe. Seules les arcs « montants » (vers un
+ * sommet de rang supérieur) sont conservés, en CSR. Le graphe étant non
+ * orienté, la recherche avant et la recherche arrière utilisent les mêmes arcs.
+ *
+ * Le résultat est sauvegardé à côté des données OSM (defaultPath) et relu au
+ * démarrage ; une empreinte du graphe invalide le fichier si l'extrait change.
+ *
+ * Requêtes :
+ *  - distance / route point à point : Dijkstra bidirectionnel montant,
+ *    raccourcis dépliés récursivement ;
+ *  - distanceTable plusieurs-à-plusieurs : recherches arrière déposées dans
+ *    des « buckets », puis une recherche avant par source.
+ * Les requêtes sont const et utilisables depuis plusieurs threads.
+ *
+ * Les distances coïncident avec celles de RoutePlanner::astar (mêmes routes
+ * praticables, Vehicule::isValidRoad).
+ */
+class ContractionHierarchy {
+public:
+    static constexpr uint32_t kNoMiddle = UINT32_MAX;
+
+    // Arc montant : target est de rang supérieur ; middle = sommet contourné (raccourci)
+    struct Arc {
+        uint32_t target;
+        uint32_t middle;
+        double weight;
+    };
+
+    ContractionHierarchy() = default;
+
+    /**
+     * @brief Construit la hiérarchie (plusieurs secondes sur une ville entière)
+     */
+    void build(const RoadGraph& graph);
+
+    /**
+     * @brief Sauvegarde au format binaire
+     * @return false en cas d'erreur d'écriture
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Relit une hiérarchie sauvegardée pour ce graphe
+     * @return false si le fichier est absent, invalide ou construit pour un autre graphe
+     */
+    bool load(const std::string& path, const RoadGraph& graph);
+
+    // Fichier associé à un extrait OSM (ex. strasbourg.osm.pbf -> strasbourg.osm.pbf.ch)
+    static std::string defaultPath(const std::string& graphFile) { return graphFile + ".ch"; }
+
+    bool isReady() const { return !m_rank.empty(); }
+
+    /**
+     * @brief Distance la plus courte (mètres), +inf si inaccessible
+     */
+    double distance(Vertex origin, Vertex destination) const;
+
+    /**
+     * @brief Plus court chemin (sommets du graphe d'origine, extrémités incluses)
+     * @return false si la destination est inaccessible
+     */
+    bool route(Vertex origin, Vertex destination, std::vector<Vertex>& path) const;
+
+    /**
+     * @brief Matrice des distances sources x cibles (ligne par source), +inf si inaccessible
+     */
+    std::vector<double> distanceTable(const std::vector<Vertex>& sources,
+                                      const std::vector<Vertex>& targets) const;
+
+    size_t vertexCount() const { return m_rank.size(); }
+    size_t arcCount() const { return m_arcs.size(); }
+    size_t shortcutCount() const { return m_shortcuts; }
+
+    void printSummary() const;
+
+private:
+    const Arc* arcsBegin(uint32_t v) const { return m_arcs.data() + m_offsets[v]; }
+    const Arc* arcsEnd(uint32_t v) const { return m_arcs.data() + m_offsets[v + 1]; }
+
+    // Arc entre a et b (stocké chez le sommet de rang inférieur), nullptr si absent
+    const Arc* findArc(uint32_t a, uint32_t b) const;
+
+    // Vérifie une hiérarchie relue (rangs, CSR, arcs et raccourcis) avant de l'utiliser
+    static bool isConsistent(const std::vector<uint32_t>& rank, const std::vector<uint32_t>& offsets,
+                             const std::vector<Arc>& arcs);
+
+    // Ajoute à path les sommets après a jusqu'à b en dépliant les raccourcis
+    void unpack(uint32_t a, uint32_t b, uint32_t middle, std::vector<Vertex>& path) const;
+
+    // Recherche bidirectionnelle ; renvoie le sommet de rencontre (ou n si aucun)
+    uint32_t search(uint32_t origin, uint32_t destination, double& best) const;
+
+    std::vector<uint32_t> m_rank;      // ordre de contraction
+    std::vector<uint32_t> m_offsets;   // CSR : arcs montants de v dans [m_offsets[v], m_offsets[v+1])
+    std::vector<Arc> m_arcs;
+    size_t m_shortcuts = 0;
+    uint64_t m_fingerprint = 0;
+};
+
+#endif // CONTRACTION_HIERARCHY_H
@@ -0,0 +1,133 @@
+#ifndef DISSEMINATION_H
+#define DISSEMINATION_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "interference_graph.h"
+
+/**
+ * @brief Diffusion multi-sauts de messages sur le graphe d'interférence
+ *
+ * Un message injecté chez un véhicule progresse d'un saut par slot radio le
+ * long des connexions directes (CSR de la génération courante) :
+ *  - Flooding : chaque véhicule réémet une seule fois, au slot qui suit sa
+ *    réception ;
+ *  - StoreCarryForward : tout véhicule informé réémet à chaque slot, ce qui
+ *    profite de la mobilité (un véhicule porteur rencontre de nouveaux voisins).
+ *
+ * Les véhicules reçoivent un numéro interne stable (leur id peut changer
+ * d'index dense d'une génération à l'autre). Chaque message garde un
+ * ensemble « déjà reçu » en bitset sur ces numéros et la liste de ses
+ * porteurs dans l'ordre de réception, dont la fin constitue la frontière :
+ * un slot ne coûte que les voisins des émetteurs.
+ *
+ * Pour chaque réception : latence (slots depuis l'injection) et nombre de
+ * sauts, agrégés par message et, sur demande, journalisés (Delivery).
+ * Non thread-safe : à utiliser depuis un seul thread (simulation, balayage).
+ */
+class DisseminationEngine {
+public:
+    enum class Mode { Flooding, StoreCarryForward };
+
+    static constexpr int kUnlimitedHops = -1;
+
+    struct MessageStats {
+        int messageId = -1;
+        int sourceId = -1;
+        uint64_t injectSlot = 0;
+        uint64_t lastDeliverySlot = 0;
+        int delivered = 0;              // véhicules atteints (source exclue)
+        int maxHops = 0;
+        double sumHops = 0.0;
+        double sumLatencySlots = 0.0;
+        bool active = true;             // encore en cours de diffusion
+
+        double meanHops() const { return delivered ? sumHops / delivered : 0.0; }
+        double meanLatencySlots() const { return delivered ? sumLatencySlots / delivered : 0.0; }
+    };
+
+    struct Delivery {
+        int messageId;
+        int vehicleId;
+        uint32_t latencySlots;
+        uint16_t hops;
+    };
+
+    explicit DisseminationEngine(Mode mode = Mode::Flooding, double slotSeconds = 0.001);
+
+    /**
+     * @brief Injecte un message chez un véhicule (reçu par lui au slot courant)
+     * @param hopLimit nombre maximal de sauts (TTL), kUnlimitedHops sinon
+     * @param lifetimeSlots durée de vie en slots (0 : illimitée ; recommandé en StoreCarryForward)
+     * @return identifiant du message
+     */
+    int inject(int sourceVehicleId, int hopLimit = kUnlimitedHops, uint64_t lifetimeSlots = 0);
+
+    /**
+     * @brief Avance de slots slots radio sur la topologie gen
+     */
+    void step(const InterferenceGraph::Generation& gen, int slots = 1);
+
+    uint64_t currentSlot() const { return m_slot; }
+    double slotSeconds() const { return m_slotSeconds; }
+    Mode mode() const { return m_mode; }
+
+    size_t messageCount() const { return m_messages.size(); }
+    size_t activeMessageCount() const { return m_active.size(); }
+    const MessageStats& stats(int messageId) const { return m_messages[messageId].stats; }
+
+    // Véhicule déjà atteint par le message (source comprise)
+    bool hasReceived(int messageId, int vehicleId) const;
+
+    // Journal détaillé des réceptions (désactivé par défaut)
+    void setRecordDeliveries(bool record) { m_recordDeliveries = record; }
+    const std::vector<Delivery>& deliveries() const { return m_deliveries; }
+    void clearDeliveries() { m_deliveries.clear(); }
+
+    // Oublie tous les messages (les numéros internes des véhicules sont conservés)
+    void clear();
+
+private:
+    struct Carrier {
+        uint32_t slot;       // numéro interne du véhicule
+        uint16_t hops;
+    };
+
+    struct Message {
+        MessageStats stats;
+        int hopLimit;
+        uint64_t expirySlot;                // 0 : jamais
+        std::vector<uint64_t> seen;         // bitset sur les numéros internes
+        std::vector<Carrier> carriers;      // porteurs dans l'ordre de réception
+        size_t frontierBegin = 0;           // reçus au dernier slot : [frontierBegin, fin)
+    };
+
+    uint32_t slotOf(int vehicleId);
+    void bindGeneration(const InterferenceGraph::Generation& gen);
+    bool testAndSet(Message& msg, uint32_t slot);
+    void transmit(Message& msg);
+
+    Mode m_mode;
+    double m_slotSeconds;
+    uint64_t m_slot = 0;
+
+    // Numéros internes stables des véhicules
+    std::unordered_map<int, uint32_t> m_slotOf;
+    std::vector<int> m_vehicleOf;
+
+    // Correspondances avec la génération courante (recalculées quand l'époque change)
+    uint64_t m_boundEpoch = 0;
+    const InterferenceGraph::Generation* m_gen = nullptr;
+    std::vector<uint32_t> m_indexToSlot;    // index dense -> numéro interne
+    std::vector<int> m_slotToIndex;         // numéro interne -> index dense (-1 si absent)
+
+    std::vector<Message> m_messages;
+    std::vector<int> m_active;              // messages encore en diffusion
+
+    bool m_recordDeliveries = false;
+    std::vector<Delivery> m_deliveries;
+};
+
+#endif // DISSEMINATION_H
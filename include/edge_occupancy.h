@@ -0,0 +1,69 @@
+#ifndef EDGE_OCCUPANCY_H
+#define EDGE_OCCUPANCY_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <limits>
+
+#include "graph_types.h"
+
+class Vehicule;
+
+/**
+ * @brief Occupation des routes : pour chaque arête orientée (from -> to),
+ * la liste des véhicules triée par positionOnEdge croissante.
+ *
+ * Les véhicules sont désignés par leur index dans le vecteur du simulateur.
+ * La mise à jour est incrémentale : seuls les véhicules qui changent d'arête
+ * sont déplacés d'une liste à l'autre, puis chaque liste (presque triée) est
+ * remise en ordre par insertion. Le véhicule de tête et le suiveur sont
+ * ensuite obtenus en O(1), indépendamment du graphe radio.
+ */
+class EdgeOccupancy {
+public:
+    static constexpr double kNoGap = std::numeric_limits<double>::infinity();
+
+    /**
+     * @brief Met à jour les listes après le déplacement des véhicules
+     * @param vehicles Véhicules du simulateur (l'index sert d'identifiant)
+     */
+    void update(const std::vector<Vehicule*>& vehicles);
+
+    void clear();
+
+    /**
+     * @brief Véhicule immédiatement devant / derrière sur la même arête orientée
+     * @return index du véhicule, -1 s'il n'y en a pas
+     */
+    int leaderOf(int vehicleIndex) const;
+    int followerOf(int vehicleIndex) const;
+
+    /**
+     * @brief Distance (m) au véhicule de tête sur la même arête, kNoGap s'il n'y en a pas
+     */
+    double gapToLeader(int vehicleIndex, const std::vector<Vehicule*>& vehicles) const;
+
+    /**
+     * @brief Véhicules présents sur l'arête orientée from -> to (du plus en arrière au plus en avant)
+     * @return nullptr si l'arête est vide
+     */
+    const std::vector<int>* lane(Vertex from, Vertex to) const;
+
+private:
+    static constexpr uint64_t kNoLane = std::numeric_limits<uint64_t>::max();
+    static uint64_t laneKey(Vertex from, Vertex to) { return (uint64_t(from) << 32) | uint64_t(uint32_t(to)); }
+
+    struct Slot {
+        uint64_t lane = kNoLane;  // arête orientée occupée
+        int pos = -1;             // rang dans la liste de l'arête
+    };
+
+    void removeFromLane(int vehicleIndex);
+
+private:
+    std::unordered_map<uint64_t, std::vector<int>> m_lanes;  // arête orientée -> véhicules triés
+    std::vector<Slot> m_slots;                               // index véhicule -> emplacement
+};
+
+#endif // EDGE_OCCUPANCY_H
@@ -0,0 +1,96 @@
+#ifndef GEOGRAPHIC_FORWARDING_H
+#define GEOGRAPHIC_FORWARDING_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "interference_graph.h"
+
+/**
+ * @brief Routage géographique glouton (mode « greedy » de GPSR)
+ *
+ * À chaque saut, le véhicule porteur transmet au voisin direct le plus
+ * proche de la destination, à condition qu'il soit plus proche que lui ;
+ * sinon le paquet est bloqué dans un minimum local (pas de mode périmètre).
+ *
+ * La table de voisins d'un véhicule est directement sa plage CSR dans la
+ * génération : aucune copie. Les positions projetées de la génération
+ * (Generation::xAt, yAt) sont comparées en distance euclidienne au carré,
+ * sans trigonométrie par décision.
+ *
+ * Non thread-safe (tampon de chemin) : une instance par thread.
+ */
+class GeographicForwarding {
+public:
+    enum class Outcome {
+        Delivered,          // destination atteinte
+        LocalMinimum,       // aucun voisin plus proche de la destination
+        HopLimit,           // nombre maximal de sauts atteint
+        UnknownVehicle      // source ou destination absente de la génération
+    };
+
+    struct Result {
+        Outcome outcome = Outcome::UnknownVehicle;
+        int hops = 0;               // sauts effectués
+        int stuckAt = -1;           // id du dernier porteur si échec
+    };
+
+    /**
+     * @brief Bilan d'un lot de paires
+     *
+     * Le taux de succès est rapporté aux paires connectées (un chemin existe) :
+     * aucun routage ne peut faire mieux. L'étirement est le rapport entre les
+     * sauts gloutons et le minimum (getShortestHopPath), sur les paires livrées.
+     */
+    struct Stats {
+        long attempts = 0;
+        long connected = 0;         // paires entre lesquelles un chemin existe
+        long delivered = 0;
+        long localMinima = 0;       // échecs en minimum local alors qu'un chemin existait
+        long hopLimited = 0;
+        double sumStretch = 0.0;
+        long stretchSamples = 0;
+        int maxStretchHops = 0;     // plus grand surcoût en sauts (glouton - optimal)
+
+        double successRate() const { return connected ? double(delivered) / connected : 0.0; }
+        double meanStretch() const { return stretchSamples ? sumStretch / stretchSamples : 0.0; }
+    };
+
+    explicit GeographicForwarding(int maxHops = 64);
+
+    /**
+     * @brief Prochain saut glouton (indices denses), -1 en minimum local
+     */
+    int nextHop(const InterferenceGraph::Generation& gen, int current, int destination);
+
+    /**
+     * @brief Achemine un paquet de sourceId vers destinationId
+     * @param path si non nul, ids des porteurs successifs (source incluse)
+     */
+    Result forward(const InterferenceGraph::Generation& gen, int sourceId, int destinationId,
+                   std::vector<int>* path = nullptr);
+
+    /**
+     * @brief Achemine chaque paire et agrège succès, étirement et minima locaux
+     * @param computeStretch calcule le chemin optimal de chaque paire livrée (BFS bidirectionnel)
+     */
+    Stats evaluate(const InterferenceGraph::Generation& gen,
+                   const std::vector<std::pair<int, int>>& pairs, bool computeStretch = true);
+
+    int maxHops() const { return m_maxHops; }
+    void setMaxHops(int maxHops) { m_maxHops = maxHops; }
+
+private:
+    static double squaredDistance(const InterferenceGraph::Generation& gen, int a, int b) {
+        const double dx = gen.xAt(a) - gen.xAt(b);
+        const double dy = gen.yAt(a) - gen.yAt(b);
+        return dx * dx + dy * dy;
+    }
+
+    int m_maxHops;
+
+    std::vector<int> m_optimal;     // tampon pour getShortestHopPath
+};
+
+#endif // GEOGRAPHIC_FORWARDING_H
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <boost/graph/adjacency_list.hpp>
@@ -17,6 +18,9 @@ public:
     // Calcule la distance géographique entre deux points (en mètres)
     static double distance(double lat1, double lon1, double lat2, double lon2);
 
+    // Empreinte du graphe (taille et identifiants OSM) pour valider les fichiers qui en dépendent
+    static uint64_t fingerprint(const RoadGraph& graph);
+
     // Affiche un résumé du graphe (nombre de sommets et d’arêtes)
     void printSummary() const;
 
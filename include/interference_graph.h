@@ -4,9 +4,39 @@
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
-#include <queue>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "simulation_snapshot.h"
+#include "propagation.h"
 
 class Vehicule;
+class KineticLinks;
+
+/**
+ * @brief Changements de liens entre deux générations consécutives
+ *
+ * Liens en ids véhicules (plus petit id en premier), triés. Une fusion
+ * réunit plusieurs composantes de la génération précédente ; une scission
+ * éclate une composante précédente. Chaque événement donne la composante
+ * concernée (dans la nouvelle génération pour une fusion, dans la précédente
+ * pour une scission) et un véhicule de chaque morceau.
+ */
+struct LinkChanges {
+    struct ComponentEvent {
+        int component;
+        std::vector<int> parts;
+    };
+
+    uint64_t fromEpoch = 0;                     // 0 : aucune génération suivie avant celle-ci
+    std::vector<std::pair<int, int>> added;
+    std::vector<std::pair<int, int>> removed;
+    std::vector<ComponentEvent> merges;
+    std::vector<ComponentEvent> splits;
+
+    bool empty() const { return added.empty() && removed.empty(); }
+};
 
 /**
  * @brief Graphe d'interférence pour gérer la communication entre véhicules
@@ -16,9 +46,159 @@ class Vehicule;
  * 1. Ils sont dans la portée de transmission l'un de l'autre (connexion directe)
  * 2. Ils peuvent communiquer via d'autres véhicules (connexion transitive)
  *    Si A communique avec B et B avec C, alors A et C peuvent aussi communiquer
+ *
+ * Chaque appel à buildGraph construit une nouvelle Generation immuable puis la
+ * publie par un échange atomique de pointeur. Un lecteur (n'importe quel thread)
+ * récupère la génération courante avec snapshot() et l'interroge sans verrou ;
+ * une ancienne génération est libérée quand son dernier lecteur la relâche.
  */
 class InterferenceGraph {
 public:
+    /**
+     * @brief Génération immuable du graphe (résultat d'un buildGraph)
+     *
+     * Les véhicules sont numérotés par un index dense [0, vehicleCount()).
+     * Les connexions directes sont stockées au format CSR (voisins triés) et la
+     * connexion transitive par l'étiquette de composante connexe : deux véhicules
+     * communiquent (directement ou par relais) s'ils ont la même composante.
+     */
+    class Generation {
+    public:
+        // Unique parmi toutes les générations publiées, tous graphes confondus (0 : génération
+        // vide initiale) : (adresse, époque) identifie une génération même si l'adresse est réutilisée
+        uint64_t epoch() const { return m_epoch; }
+        int vehicleCount() const { return int(m_ids.size()); }
+
+        // Correspondance id véhicule <-> index dense (-1 si absent)
+        int indexOf(int vehicleId) const;
+        int idAt(int index) const { return m_ids[index]; }
+
+        // Position (degrés) de l'index i au moment de la construction
+        double latAt(int index) const { return m_lat[index]; }
+        double lonAt(int index) const { return m_lon[index]; }
+
+        // Position projetée (mètres, vers l'est et vers le nord) : projection équirectangulaire
+        // autour de la latitude moyenne de la génération, précise à l'échelle d'une ville
+        double xAt(int index) const { return m_x[index]; }
+        double yAt(int index) const { return m_y[index]; }
+
+        // Voisins directs de l'index i : [neighborsBegin(i), neighborsEnd(i)), indices denses triés
+        const int* neighborsBegin(int index) const { return m_neighbors.data() + m_offsets[index]; }
+        const int* neighborsEnd(int index) const { return m_neighbors.data() + m_offsets[index + 1]; }
+        int degree(int index) const { return m_offsets[index + 1] - m_offsets[index]; }
+        int linkCount() const { return int(m_neighbors.size() / 2); }
+
+        // Composante connexe de l'index i et ses membres (indices denses)
+        int componentOf(int index) const { return m_component[index]; }
+        int componentCount() const { return int(m_componentOffsets.size()) - 1; }
+        const int* componentBegin(int component) const { return m_componentMembers.data() + m_componentOffsets[component]; }
+        const int* componentEnd(int component) const { return m_componentMembers.data() + m_componentOffsets[component + 1]; }
+        int componentSize(int component) const { return m_componentOffsets[component + 1] - m_componentOffsets[component]; }
+
+        /**
+         * Mode orienté (setDirectedLinksEnabled) : arc i -> j dès que i atteint j,
+         * même si j n'atteint pas i. Arcs au format CSR (cibles triées) et
+         * composantes fortement connexes (atteignabilité mutuelle par relais).
+         * Hors mode orienté, ces tableaux sont vides.
+         */
+        bool hasDirectedLinks() const { return m_directed; }
+        const int* outBegin(int index) const { return m_outArcs.data() + m_outOffsets[index]; }
+        const int* outEnd(int index) const { return m_outArcs.data() + m_outOffsets[index + 1]; }
+        int outDegree(int index) const { return m_outOffsets[index + 1] - m_outOffsets[index]; }
+        int arcCount() const { return int(m_outArcs.size()); }
+        int sccOf(int index) const { return m_scc[index]; }
+        int sccCount() const { return m_sccCount; }
+
+        /**
+         * Suivi des changements (setChangeTrackingEnabled) : liens apparus et
+         * disparus depuis la génération précédente, fusions et scissions.
+         */
+        bool hasChanges() const { return m_tracked; }
+        const LinkChanges& changes() const { return m_changes; }
+
+        // Même sémantique que les méthodes homonymes d'InterferenceGraph (par id véhicule)
+        bool canCommunicate(int id1, int id2) const;
+        bool canReach(int fromId, int toId) const;
+        bool stronglyConnected(int id1, int id2) const;
+        std::unordered_set<int> getDirectedReachableVehicles(int vehicleId) const;
+        std::unordered_set<int> getReachableVehicles(int vehicleId) const;
+        std::unordered_set<int> getDirectNeighbors(int vehicleId) const;
+        int getDirectNeighborCount(int vehicleId) const;
+
+        /**
+         * @brief Véhicules joignables en au plus maxHops sauts (limite de TTL)
+         * @param out ids des véhicules atteints, source exclue, par nombre de sauts croissant
+         * @param hops si non nul, nombre de sauts de chaque entrée de out
+         * @return nombre de véhicules atteints (0 si la source est absente ou maxHops < 1)
+         *
+         * BFS borné sur le CSR : seul le voisinage à k sauts est parcouru, sans
+         * matérialiser la composante entière.
+         */
+        int getVehiclesWithinHops(int vehicleId, int maxHops, std::vector<int>& out,
+                                  std::vector<int>* hops = nullptr) const;
+
+        /**
+         * @brief Version par lot : un BFS borné par source
+         * @param offsets résultat au format CSR : ids de sources[s] dans ids[offsets[s], offsets[s+1])
+         */
+        void getVehiclesWithinHops(const std::vector<int>& sources, int maxHops,
+                                   std::vector<int>& offsets, std::vector<int>& ids) const;
+
+        /**
+         * @brief Chaîne de relais la plus courte (en sauts) entre deux véhicules
+         * @param path ids de la source à la destination, extrémités incluses
+         * @return false si les véhicules ne communiquent pas (path vide)
+         *
+         * BFS bidirectionnel sur le CSR : on étend à chaque fois le côté dont la
+         * frontière est la plus petite ; composantes différentes -> échec immédiat.
+         */
+        bool getShortestHopPath(int sourceId, int destinationId, std::vector<int>& path) const;
+
+        /**
+         * @brief Version par lot (ex. toutes les paires à router dans un tick)
+         * @param offsets résultat au format CSR : chemin de pairs[p] dans ids[offsets[p], offsets[p+1]),
+         *        vide si la paire ne communique pas
+         */
+        void getShortestHopPaths(const std::vector<std::pair<int, int>>& pairs,
+                                 std::vector<int>& offsets, std::vector<int>& ids) const;
+
+        /**
+         * @brief Remplit snap.links et snap.component pour les véhicules de snap.vehicles
+         * (appariés par id ; un véhicule absent de la génération est isolé)
+         */
+        void exportLinks(SimulationSnapshot& snap) const;
+
+    private:
+        friend class InterferenceGraph;
+
+        uint64_t m_epoch = 0;
+        std::vector<int> m_ids;                     // index dense -> id véhicule
+        std::unordered_map<int, int> m_indexOf;     // id véhicule -> index dense
+        std::vector<double> m_lat;                  // index dense -> latitude
+        std::vector<double> m_lon;                  // index dense -> longitude
+        std::vector<double> m_x;                    // index dense -> abscisse projetée (m)
+        std::vector<double> m_y;                    // index dense -> ordonnée projetée (m)
+        std::vector<int> m_offsets{0};              // CSR : début des voisins de chaque index
+        std::vector<int> m_neighbors;               // CSR : voisins directs (indices denses)
+        std::vector<int> m_component;               // index -> composante connexe
+        std::vector<int> m_componentOffsets{0};     // composante -> début de ses membres
+        std::vector<int> m_componentMembers;        // membres groupés par composante
+
+        // Mode orienté
+        bool m_directed = false;
+        std::vector<int> m_outOffsets;              // CSR : début des arcs sortants de chaque index
+        std::vector<int> m_outArcs;                 // CSR : cibles des arcs (indices denses)
+        std::vector<int> m_scc;                     // index -> composante fortement connexe
+        int m_sccCount = 0;
+
+        // Suivi des changements
+        bool m_tracked = false;
+        std::vector<uint64_t> m_linkKeys;           // liens (id min << 32 | id max), triés
+        LinkChanges m_changes;
+    };
+
+    using GenerationPtr = std::shared_ptr<const Generation>;
+
     InterferenceGraph();
     ~InterferenceGraph();
 
@@ -28,14 +208,81 @@ public:
      * 
      * Étape 1: Connexions directes basées sur la portée de transmission
      * Étape 2: Calcul de la fermeture transitive pour les connexions indirectes
+     * Étape 3: Mise à jour des voisins (accessibles) de chaque véhicule
      */
     void buildGraph(const std::vector<Vehicule*>& vehicles);
 
     /**
-     * @brief Efface toutes les connexions du graphe
+     * @brief Construit le graphe à partir de positions seules (sans objets Vehicule)
+     * @param states Identifiant, position et portée de chaque véhicule
+     */
+    void buildGraph(const std::vector<VehicleState>& states);
+
+    /**
+     * @brief Choisit le modèle de propagation des constructions suivantes
+     * @param params Paramètres radio (LogDistance et Shadowing uniquement)
+     *
+     * À appeler depuis le thread qui construit le graphe. Les tables du modèle
+     * sont calculées ici, une fois, et non à chaque construction.
+     */
+    void setPropagationModel(PropagationModel model, const RadioParams& params = RadioParams());
+    PropagationModel propagationModel() const { return m_model; }
+    const RadioParams& radioParams() const { return m_radio; }
+
+    /**
+     * @brief Mode orienté : conserve aussi les liens à sens unique (portées hétérogènes)
+     *
+     * Les connexions directes et les composantes restent bidirectionnelles ;
+     * chaque génération porte en plus les arcs et les composantes fortement
+     * connexes (voir Generation::hasDirectedLinks). À appeler depuis le thread
+     * qui construit le graphe.
+     */
+    void setDirectedLinksEnabled(bool enabled) { m_directedLinks = enabled; }
+    bool directedLinksEnabled() const { return m_directedLinks; }
+
+    /**
+     * @brief Suivi des changements de liens d'une génération à la suivante
+     *
+     * Chaque génération publiée porte alors ses LinkChanges, obtenus en
+     * fusionnant les tableaux triés de liens des deux générations ; fusions et
+     * scissions ne sont cherchées qu'autour des liens modifiés. La première
+     * génération suivie rapporte tous ses liens comme ajoutés. À appeler depuis
+     * le thread qui construit le graphe.
+     */
+    void setChangeTrackingEnabled(bool enabled) { m_trackChanges = enabled; }
+    bool changeTrackingEnabled() const { return m_trackChanges; }
+
+    /**
+     * @brief Mode cinétique : les paires ne sont retestées qu'à l'échéance de leur certificat
+     * @param enabled false revient au test de toutes les paires à chaque construction
+     * @param horizon Marge (mètres) au-delà du seuil de lien pour suivre une paire
+     *
+     * Mêmes liens qu'avec le test de toutes les paires (voir KineticLinks) ;
+     * le mode orienté teste toujours toutes les paires. Changer de modèle de
+     * propagation réinitialise les certificats. À appeler depuis le thread qui
+     * construit le graphe.
+     */
+    void setKineticLinksEnabled(bool enabled, double horizon = 500.0);
+    const KineticLinks* kineticLinks() const { return m_kinetic.get(); }
+
+    /**
+     * @brief Efface toutes les connexions du graphe (publie une génération vide)
      */
     void clear();
 
+    /**
+     * @brief Génération courante, utilisable depuis n'importe quel thread
+     *
+     * Le pointeur retourné garde la génération en vie ; les requêtes dessus
+     * ne prennent aucun verrou et ne voient jamais un graphe à moitié construit.
+     */
+    GenerationPtr snapshot() const;
+
+    /**
+     * @brief Numéro de la génération courante (incrémenté à chaque construction)
+     */
+    uint64_t epoch() const { return snapshot()->epoch(); }
+
     /**
      * @brief Vérifie si deux véhicules peuvent communiquer (directement ou indirectement)
      * @param id1 ID du premier véhicule
@@ -44,6 +291,12 @@ public:
      */
     bool canCommunicate(int id1, int id2) const;
 
+    /**
+     * @brief Vérifie si un message de fromId peut atteindre toId, en suivant les arcs
+     * (mode orienté ; sinon identique à canCommunicate)
+     */
+    bool canReach(int fromId, int toId) const;
+
     /**
      * @brief Obtient tous les véhicules avec lesquels un véhicule peut communiquer
      * @param vehicleId ID du véhicule
@@ -58,10 +311,32 @@ public:
      */
     std::unordered_set<int> getDirectNeighbors(int vehicleId) const;
 
+    /**
+     * @brief Nombre de voisins directs d'un véhicule, sans copier l'ensemble
+     * @param vehicleId ID du véhicule
+     */
+    int getDirectNeighborCount(int vehicleId) const;
+
+    /**
+     * @brief Véhicules joignables en au plus maxHops sauts (voir Generation::getVehiclesWithinHops)
+     * @param vehicleId ID du véhicule source
+     * @param maxHops Nombre maximal de sauts (TTL du message)
+     * @return IDs des véhicules atteints, par nombre de sauts croissant
+     */
+    std::vector<int> getVehiclesWithinHops(int vehicleId, int maxHops) const;
+
+    /**
+     * @brief Plus courte chaîne de relais entre deux véhicules (voir Generation::getShortestHopPath)
+     * @param id1 ID du véhicule source
+     * @param id2 ID du véhicule destination
+     * @return IDs des véhicules de id1 à id2 inclus, vide s'ils ne communiquent pas
+     */
+    std::vector<int> getShortestHopPath(int id1, int id2) const;
+
     /**
      * @brief Obtient le nombre de véhicules dans le graphe
      */
-    int getVehicleCount() const { return m_adjacencyList.size(); }
+    int getVehicleCount() const { return snapshot()->vehicleCount(); }
 
     /**
      * @brief Affiche les statistiques du graphe (pour debug)
@@ -70,25 +345,60 @@ public:
 
 private:
     /**
-     * @brief Calcule la fermeture transitive du graphe
-     * Utilise un BFS pour trouver tous les véhicules accessibles depuis chaque véhicule
+     * @brief Construit une génération : connexions directes (CSR) puis composantes connexes
+     * @param states Positions et portées, dans l'ordre des index denses
      */
-    void computeTransitiveClosure();
+    std::shared_ptr<Generation> buildGeneration(const std::vector<VehicleState>& states);
 
     /**
-     * @brief Effectue un BFS pour trouver tous les nœuds accessibles depuis un nœud source
-     * @param startId ID du véhicule de départ
-     * @return Ensemble des IDs des véhicules accessibles
+     * @brief Connexions directes selon la politique de propagation
+     * Instanciée pour chaque politique : le test de lien est intégré dans la boucle sur les paires
+     */
+    template <typename Policy>
+    static void buildLinks(const std::vector<VehicleState>& states, const Policy& policy,
+                           std::vector<std::pair<int, int>>& links,
+                           std::vector<std::pair<int, int>>* arcs);
+
+    // Connexions directes : par KineticLinks en mode cinétique non orienté, sinon buildLinks
+    template <typename Policy>
+    void findLinks(const std::vector<VehicleState>& states, const Policy& policy,
+                   std::vector<std::pair<int, int>>& links,
+                   std::vector<std::pair<int, int>>* arcs);
+
+    /**
+     * @brief Composantes fortement connexes des arcs (Tarjan itératif sur le CSR)
      */
-    std::unordered_set<int> bfsReachable(int startId) const;
+    static void computeStronglyConnected(Generation& gen);
+
+    /**
+     * @brief Calcule les composantes connexes (fermeture transitive) d'une génération
+     * Utilise un BFS itératif sur le CSR
+     */
+    static void computeTransitiveClosure(Generation& gen);
+
+    void publish(std::shared_ptr<Generation> gen);
+
+    /**
+     * @brief Liens, fusions et scissions de next par rapport à prev
+     */
+    static void computeChanges(const Generation& prev, Generation& next);
 
 private:
-    // Liste d'adjacence pour les connexions directes (basées sur la portée)
-    std::unordered_map<int, std::unordered_set<int>> m_adjacencyList;
+    // Génération courante, lue et remplacée avec std::atomic_load / std::atomic_store
+    GenerationPtr m_current;
+
+    // Compteur de générations partagé par tous les graphes
+    static std::atomic<uint64_t> s_nextEpoch;
+
+    // Modèle de propagation ; les tables de Shadowing ne sont construites que s'il est choisi
+    PropagationModel m_model = PropagationModel::UnitDisk;
+    RadioParams m_radio;
+    propagation::LogDistance m_logDistance;
+    std::unique_ptr<propagation::Shadowing> m_shadowing;
 
-    // Fermeture transitive: pour chaque véhicule, tous les véhicules accessibles
-    // (directement ou indirectement)
-    std::unordered_map<int, std::unordered_set<int>> m_transitiveClosure;
+    bool m_directedLinks = false;
+    bool m_trackChanges = false;
+    std::unique_ptr<KineticLinks> m_kinetic;
 };
 
 #endif // INTERFERENCE_GRAPH_H
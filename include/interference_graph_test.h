@@ -43,6 +43,26 @@ private:
     bool testAsymmetricRange();
     bool testCompleteGraph();
     bool testStarTopology();
+    bool testGenerationSnapshot();
+    bool testDissemination();
+    bool testHopLimitedReachability();
+    bool testShortestHopPath();
+    bool testGeographicForwarding();
+    bool testMacCollisions();
+    bool testMacContention();
+    bool testPropagationModels();
+    bool testSinrLinks();
+    bool testSinrFarField();
+    bool testDirectedLinks();
+    bool testLinkChanges();
+    bool testKineticLinks();
+    bool testEdgeOccupancy();
+    bool testRoutePlanner();
+    bool testContractionHierarchy();
+    bool testCheckpointRoundTrip();
+    bool testEventModeRestart();
+    bool testTrajectoryTrace();
+    bool testTraceReplayModel();
 
     // Fonctions utilitaires
     void printTestHeader(const std::string& testName) const;
@@ -52,6 +72,17 @@ private:
     // Création de véhicules de test avec positions fixes
     Vehicule* createTestVehicle(int id, double lat, double lon, double range);
     void cleanupVehicles(std::vector<Vehicule*>& vehicles);
+    // Chaîne V0 - V1 - ... : véhicule i sur le sommet i du graphe de test (~200m entre
+    // voisins, V4 isolé à ~5km), même portée pour tous
+    std::vector<Vehicule*> buildChain(int count, double range);
+
+    // Réseau routier de test : grille width x height à longueurs d'arêtes variées, quelques
+    // tronçons non praticables, un îlot isolé et un sommet relié uniquement par un chemin piéton
+    void buildRoadGrid(RoadGraph& graph, int width, int height, unsigned seed) const;
+    // Dijkstra de référence sur les routes praticables (+inf si inaccessible)
+    static double referenceDistance(const RoadGraph& graph, Vertex origin, Vertex destination);
+    // Longueur d'un itinéraire, -1 si deux sommets consécutifs ne sont pas reliés par une route praticable
+    static double routeLength(const RoadGraph& graph, const std::vector<Vertex>& path);
 
 private:
     // Statistiques des tests
@@ -0,0 +1,229 @@
+#ifndef KINETIC_LINKS_H
+#define KINETIC_LINKS_H
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "simulation_snapshot.h"
+#include "calendar_queue.h"
+#include "graph_builder.h"
+
+/**
+ * @brief Liens non orientés maintenus d'un tick à l'autre (structure cinétique)
+ *
+ * Au lieu de tester toutes les paires à chaque tick, chaque paire proche
+ * reçoit un certificat : à distance d d'un seuil T (linkDistance de la
+ * politique), son état ne peut pas changer tant que les deux véhicules
+ * n'ont pas parcouru ensemble |d - T| mètres (inégalité triangulaire). Le
+ * parcours de chaque véhicule est mesuré d'un tick à l'autre sur ses
+ * positions : virages, accélérations ou téléportations restent couverts,
+ * là où une extrapolation des vitesses devrait être corrigée après coup.
+ *
+ * Les échéances sont rangées sur un « odomètre » global (somme, tick après
+ * tick, du plus grand déplacement) : une paire arrive à échéance quand
+ * l'odomètre a avancé de la moitié de sa marge. Elle est alors revue avec
+ * le parcours réel des deux véhicules : si la marge n'est pas consommée,
+ * elle est reprogrammée sans calcul de distance.
+ *
+ * Seules les paires à moins de T + horizon sont suivies. Un véhicule
+ * rebalaie toutes les autres paires chaque fois qu'il a parcouru horizon / 2
+ * depuis son dernier balayage, ainsi qu'à son arrivée et quand sa portée
+ * change : une paire non suivie ne peut pas se rapprocher de plus d'horizon
+ * entre deux balayages.
+ *
+ * Le résultat est identique à un test de toutes les paires. Non
+ * thread-safe : utilisé par InterferenceGraph depuis le thread qui construit
+ * le graphe.
+ */
+class KineticLinks {
+public:
+    struct Stats {
+        long distanceTests = 0;     // calculs de distance entre véhicules
+        long rescans = 0;           // véhicules ayant rebalayé toutes les paires
+        long certificates = 0;      // échéances traitées
+        long trackedPairs = 0;      // paires suivies après la mise à jour
+    };
+
+    explicit KineticLinks(double horizon = 500.0);
+
+    /**
+     * @brief Liens entre les véhicules de states (indices dans states, i < j)
+     *
+     * Policy : politique de propagation (propagation.h). Les ids doivent être
+     * uniques ; la politique doit rester la même d'un appel à l'autre (sinon
+     * clear()).
+     */
+    template <typename Policy>
+    void update(const std::vector<VehicleState>& states, const Policy& policy,
+                std::vector<std::pair<int, int>>& links);
+
+    // Oublie tous les véhicules et certificats
+    void clear();
+
+    // Bilan de la dernière mise à jour
+    const Stats& stats() const { return m_stats; }
+
+    double horizon() const { return m_horizon; }
+
+private:
+    static constexpr double kEpsilon = 1e-6;    // mètres, arrondis du calcul de distance
+
+    struct Slot {
+        int id = -1;
+        int index = -1;             // index dans states pour ce tick, -1 si absent
+        double lat = 0.0, lon = 0.0;
+        double range = 0.0;
+        double odometer = 0.0;      // distance parcourue depuis son arrivée
+        double scannedAt = 0.0;     // odomètre au dernier balayage
+        uint32_t scanStamp = 0;     // = m_tick si balayé pendant ce tick
+        uint32_t pairWith = kNone;  // pendant un balayage : paire avec le véhicule balayé
+        std::vector<std::pair<uint32_t, uint32_t>> partners;   // (slot, paire) suivies
+    };
+
+    struct Pair {
+        uint32_t a, b;              // slots ; a == kNone si l'entrée est libre
+        double base;                // somme des odomètres au dernier test
+        double slack;               // marge |d - T|
+        uint64_t seq;               // numéro de son événement en attente
+        bool linked;
+    };
+
+    struct Event {
+        double time;                // échéance sur l'odomètre global
+        uint64_t seq;
+        uint32_t pair;
+    };
+
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    // Place les véhicules du tick dans leurs slots, fait avancer les odomètres
+    // et remplit m_toScan ; libère les véhicules absents
+    void bind(const std::vector<VehicleState>& states);
+    void release(uint32_t slot);
+    uint32_t addPair(uint32_t a, uint32_t b);
+    void erasePair(uint32_t p);
+    void schedule(uint32_t p, double remaining);
+
+    // Teste la paire (a, b) ; p : son entrée si elle est suivie, kNone sinon
+    template <typename Policy>
+    void test(uint32_t a, uint32_t b, uint32_t p, const std::vector<VehicleState>& states, const Policy& policy);
+
+    template <typename Policy>
+    void rescan(uint32_t slot, const std::vector<VehicleState>& states, const Policy& policy);
+
+    double m_horizon;
+    std::vector<Slot> m_slots;
+    std::unordered_map<int, uint32_t> m_slotOf;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<uint32_t> m_active;             // slots présents, dans l'ordre de states
+    std::vector<uint32_t> m_toScan;
+    std::vector<std::pair<uint32_t, uint32_t>> m_scratch;
+
+    std::vector<Pair> m_pairs;
+    std::vector<uint32_t> m_freePairs;
+    CalendarQueue<Event> m_events;
+    std::vector<Event> m_deferred;
+    double m_odometer = 0.0;
+    uint64_t m_nextSeq = 0;
+    uint32_t m_tick = 0;
+
+    Stats m_stats;
+};
+
+template <typename Policy>
+void KineticLinks::test(uint32_t a, uint32_t b, uint32_t p, const std::vector<VehicleState>& states,
+                        const Policy& policy) {
+    const VehicleState& sa = states[m_slots[a].index];
+    const VehicleState& sb = states[m_slots[b].index];
+    const double distance = GraphBuilder::distance(sa.lat, sa.lon, sb.lat, sb.lon);
+    ++m_stats.distanceTests;
+
+    // Trop loin pour être suivie : les balayages la couvrent
+    const double threshold = policy.linkDistance(sa, sb);
+    if (distance > threshold + m_horizon) {
+        if (p != kNone) erasePair(p);
+        return;
+    }
+
+    if (p == kNone) p = addPair(a, b);
+    Pair& pair = m_pairs[p];
+    pair.base = m_slots[a].odometer + m_slots[b].odometer;
+    pair.slack = std::max(0.0, std::abs(distance - threshold) - kEpsilon);
+    pair.linked = policy.linked(sa, sb, distance);
+    schedule(p, pair.slack);
+}
+
+template <typename Policy>
+void KineticLinks::rescan(uint32_t slot, const std::vector<VehicleState>& states, const Policy& policy) {
+    ++m_stats.rescans;
+    m_slots[slot].scannedAt = m_slots[slot].odometer;
+    m_slots[slot].scanStamp = m_tick;
+
+    // Paires déjà suivies, repérées chez l'autre véhicule (la liste change pendant le balayage)
+    m_scratch = m_slots[slot].partners;
+    for (const auto& [other, p] : m_scratch) m_slots[other].pairWith = p;
+
+    // Les paires avec un véhicule déjà balayé pendant ce tick sont à jour
+    for (uint32_t other : m_active) {
+        if (other != slot && m_slots[other].scanStamp != m_tick) {
+            test(slot, other, m_slots[other].pairWith, states, policy);
+        }
+    }
+    for (const auto& entry : m_scratch) m_slots[entry.first].pairWith = kNone;
+}
+
+template <typename Policy>
+void KineticLinks::update(const std::vector<VehicleState>& states, const Policy& policy,
+                          std::vector<std::pair<int, int>>& links) {
+    m_stats = Stats();
+    bind(states);
+
+    // Les certificats posés pendant ce tick décrivent déjà les positions courantes
+    const uint64_t firstNew = m_nextSeq;
+    for (uint32_t slot : m_toScan) {
+        rescan(slot, states, policy);
+    }
+
+    // Échéances atteintes : marge consommée par le parcours réel des deux véhicules ?
+    Event e;
+    m_deferred.clear();
+    while (m_events.pop(e)) {
+        if (e.time > m_odometer) {
+            m_events.push(e);
+            break;
+        }
+        if (e.seq >= firstNew) {
+            m_deferred.push_back(e);    // marge nulle : revue au prochain tick
+            continue;
+        }
+
+        Pair& pair = m_pairs[e.pair];
+        if (pair.a == kNone || pair.seq != e.seq) continue;     // périmée
+        ++m_stats.certificates;
+
+        const double used = m_slots[pair.a].odometer + m_slots[pair.b].odometer - pair.base;
+        if (used < pair.slack) {
+            schedule(e.pair, pair.slack - used);
+        } else {
+            test(pair.a, pair.b, e.pair, states, policy);
+        }
+    }
+    for (const Event& d : m_deferred) {
+        m_events.push(d);
+    }
+
+    links.clear();
+    for (const Pair& pair : m_pairs) {
+        if (pair.a == kNone || !pair.linked) continue;
+        const int i = m_slots[pair.a].index;
+        const int j = m_slots[pair.b].index;
+        links.push_back({std::min(i, j), std::max(i, j)});
+    }
+    m_stats.trackedPairs = long(m_pairs.size() - m_freePairs.size());
+}
+
+#endif // KINETIC_LINKS_H
@@ -0,0 +1,187 @@
+#ifndef MAC_SIMULATOR_H
+#define MAC_SIMULATOR_H
+
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <cstdint>
+
+#include "interference_graph.h"
+#include "calendar_queue.h"
+
+// Paramètres radio et MAC (valeurs par défaut proches de 802.11p)
+struct MacParams {
+    double bitrate = 6e6;           // bits/s (canal de 10 MHz)
+    double preamble = 40e-6;        // préambule + en-tête PHY (s)
+    double slotTime = 13e-6;        // slot de backoff (s)
+    double difs = 58e-6;            // écoute avant émission (s)
+    int cwMin = 15;
+    int cwMax = 1023;
+    int queueLimit = 64;            // paquets en attente par véhicule
+    double beaconInterval = 0.0;    // balises périodiques (s), 0 : aucune
+    uint32_t beaconBytes = 300;
+};
+
+/**
+ * @brief Couche radio / MAC à événements discrets (niveau paquet)
+ *
+ * Là où le graphe d'interférence considère tout lien comme parfait, ce
+ * modèle ajoute la contention :
+ *  - une file d'émission FIFO par véhicule (bornée, paquets rejetés au-delà) ;
+ *  - un accès au canal de type CSMA/CA : écoute pendant DIFS puis décompte
+ *    d'un backoff aléatoire, gelé tant que le canal est occupé et repris
+ *    après un nouveau DIFS libre ;
+ *  - une détection de porteuse qui prend un slot : une trame commencée moins
+ *    d'un slot avant l'instant d'accès n'est pas encore perçue, deux voisins
+ *    qui tirent le même slot émettent ensemble ;
+ *  - des collisions : un récepteur qui entend plusieurs trames qui se
+ *    chevauchent les perd toutes ; un véhicule en émission n'entend rien
+ *    (semi-duplex). Les terminaux cachés apparaissent naturellement.
+ * Les acquittements ne passent pas sur le canal : l'émetteur d'une trame
+ * unicast perdue l'apprend à sa fin et double sa fenêtre de contention (sans
+ * retransmission) ; elle revient à cwMin après une trame reçue ou diffusée.
+ *
+ * Le voisinage radio est celui de la génération passée à advance() : entre
+ * deux ticks de mobilité, la topologie est figée. Les récepteurs d'une trame
+ * sont fixés à son début.
+ *
+ * Les événements passent par une CalendarQueue ; paquets et trames en vol
+ * sont recyclés (listes libres, files chaînées par index) : en régime établi,
+ * aucune allocation par événement.
+ *
+ * Non thread-safe : à faire avancer depuis le thread de simulation.
+ */
+class MacSimulator {
+public:
+    static constexpr int kBroadcast = -1;
+
+    struct Stats {
+        uint64_t events = 0;
+        uint64_t enqueued = 0;
+        uint64_t queueDrops = 0;        // file pleine
+        uint64_t transmissions = 0;
+        uint64_t deferrals = 0;         // backoffs gelés par un canal occupé
+        uint64_t receptions = 0;        // trames reçues intactes (par récepteur)
+        uint64_t collisions = 0;        // trames perdues par chevauchement (par récepteur)
+        uint64_t halfDuplexLosses = 0;  // trames manquées car le récepteur émettait
+        uint64_t unicastDelivered = 0;  // trames unicast reçues par leur destinataire
+        double sumAccessDelay = 0.0;    // attente en file + accès au canal (s)
+
+        double meanAccessDelay() const { return transmissions ? sumAccessDelay / transmissions : 0.0; }
+        double lossRatio() const {
+            const uint64_t heard = receptions + collisions + halfDuplexLosses;
+            return heard ? double(collisions + halfDuplexLosses) / heard : 0.0;
+        }
+    };
+
+    explicit MacSimulator(const MacParams& params = MacParams(), uint32_t seed = 1);
+
+    /**
+     * @brief Met un paquet en file chez sourceId (à l'instant now())
+     * @param destinationId kBroadcast pour une diffusion à un saut
+     * @return false si la file du véhicule est pleine
+     */
+    bool send(int sourceId, int destinationId, uint32_t bytes);
+
+    /**
+     * @brief Traite les événements jusqu'à now() + duration sur la topologie gen
+     */
+    void advance(const InterferenceGraph::Generation& gen, double duration);
+
+    double now() const { return m_now; }
+    const Stats& stats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+    size_t pendingEvents() const { return m_events.size(); }
+    size_t queuedPackets() const { return m_queuedPackets; }
+
+    // Durée d'une trame de bytes octets sur le canal
+    double airtime(uint32_t bytes) const { return m_params.preamble + bytes * 8.0 / m_params.bitrate; }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr uint32_t kHalfDuplex = 0x80000000u;   // marque d'un récepteur qui émettait
+
+    enum class EventType : uint8_t { Access, TxEnd, Beacon };
+
+    struct Event {
+        double time;
+        uint64_t seq;
+        EventType type;
+        uint32_t target;    // nœud (Access, Beacon) ou trame (TxEnd)
+    };
+
+    struct Packet {
+        int destination;
+        uint32_t bytes;
+        double enqueueTime;
+        uint32_t next;      // suivant dans la file du nœud ou dans la liste libre
+    };
+
+    struct Transmission {
+        uint32_t packet;
+        uint32_t source;
+        std::vector<uint32_t> receivers;   // nœuds (bit kHalfDuplex si le récepteur émettait)
+        uint32_t nextFree;
+    };
+
+    // État radio d'un véhicule (indexé par un numéro interne stable)
+    struct Node {
+        int vehicleId;
+        uint32_t head = kNone;          // file d'émission chaînée
+        uint32_t tail = kNone;
+        int queued = 0;
+        int cw;
+        int backoff = -1;               // slots restant à décompter, -1 : à tirer
+        bool accessPending = false;     // un événement Access est programmé
+        double countStart = 0.0;        // début du DIFS en cours
+        double accessTime = 0.0;        // échéance de l'Access programmé
+        uint64_t accessSeq = 0;         // son numéro (les Access gelés sont périmés)
+        bool transmitting = false;
+        bool beaconing = false;         // une balise est programmée
+        int heard = 0;                  // trames en cours captées
+        uint32_t locked = kNone;        // trame en cours de réception
+        bool corrupted = false;
+    };
+
+    uint32_t nodeOf(int vehicleId);
+    void bind(const InterferenceGraph::Generation& gen);
+    uint64_t schedule(double time, EventType type, uint32_t target);
+    void scheduleAccess(uint32_t node);
+    void freezeBackoff(uint32_t node);
+
+    uint32_t allocPacket();
+    void freePacket(uint32_t p);
+    uint32_t allocTransmission();
+
+    void onAccess(uint32_t node);
+    void onTxEnd(uint32_t tx);
+    void onBeacon(uint32_t node);
+    bool enqueue(uint32_t node, int destination, uint32_t bytes);
+
+    MacParams m_params;
+    std::mt19937 m_rng;
+    double m_now = 0.0;
+    uint64_t m_nextSeq = 0;
+    CalendarQueue<Event> m_events;
+
+    std::vector<Node> m_nodes;
+    std::unordered_map<int, uint32_t> m_nodeOf;
+
+    // Génération courante : index dense <-> nœud
+    const InterferenceGraph::Generation* m_gen = nullptr;
+    uint64_t m_epoch = 0;
+    std::vector<uint32_t> m_indexToNode;
+    std::vector<int> m_nodeToIndex;
+
+    std::vector<Packet> m_packets;
+    uint32_t m_freePacket = kNone;
+    size_t m_queuedPackets = 0;
+
+    std::vector<Transmission> m_transmissions;
+    uint32_t m_freeTransmission = kNone;
+
+    Stats m_stats;
+};
+
+#endif // MAC_SIMULATOR_H
@@ -8,19 +8,16 @@
 #include <QNetworkReply>
 #include <QPointer>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <memory>
+#include <vector>
 
+#include "tile_key.h"
+#include "road_layer.h"
+#include "simulation_snapshot.h"
 
 class Simulator;
-
-struct TileKey {
-    int z;
-    int x;
-    int y;
-    bool operator==(const TileKey& o) const noexcept { return z==o.z && x==o.x && y==o.y; }
-};
-inline uint qHash(const TileKey &k, uint seed=0) noexcept {
-    return qHash((k.z*73856093) ^ (k.x*19349663) ^ (k.y*83492791), seed);
-}
+class TraceReplay;
 
 class MapView : public QWidget {
     Q_OBJECT
@@ -31,6 +28,7 @@ public:
     bool loadImage(const QString& path);
 
     // Schéma de tuiles XYZ: "https://.../{z}/{x}/{y}.png" ou "file:///.../{z}/{x}/{y}.png"
+    // (un changement vide le cache mémoire et annule les téléchargements en cours)
     void setTilesTemplate(const QString& pattern);
 
     // Centrer sur lon/lat (Web Mercator), zoom entier [0..20]
@@ -40,6 +38,9 @@ public:
     void setNetworkIdentity(const QString& ua, const QString& ref) { m_userAgent = ua; m_referer = ref; }
     void setRequestRateLimitMs(qint64 ms) { m_minRequestIntervalMs = ms; }
 
+    // Budget mémoire du cache de tuiles, en octets de pixmaps décodées
+    void setTileCacheBudgetBytes(qint64 bytes);
+
     //getter
     int zoomLevel() const { return m_zoom; }
     double centerLon() const;
@@ -48,7 +49,22 @@ public:
     double getOffsetY() const {return m_offsetY;}
 
     //setter
-    void setSimulator(Simulator* sim) { m_simulator = sim; }
+    void setSimulator(Simulator* sim);
+    void setReplay(TraceReplay* replay);   // relecture d'une trace à la place de la simulation
+    void setShowRoadNetwork(bool show);
+
+    // À appeler si le graphe routier du simulateur a été modifié
+    void invalidateRoadNetwork() { m_roadLayer.invalidate(); update(); }
+
+    // Fréquence de rendu (ms), indépendante du pas de la simulation
+    void setRenderIntervalMs(int ms);
+
+    // Mode de rendu des véhicules : Auto bascule sur la carte de densité au-delà des seuils
+    enum class RenderMode { Auto, Vehicles, Heatmap };
+    enum class HeatmapQuantity { Vehicles, Links };
+    void setRenderMode(RenderMode mode);
+    void setHeatmapThresholds(int vehicleCount, int maxZoom);
+    void setHeatmapQuantity(HeatmapQuantity q);
 
     //util
     static void lonlatToPixel(double lonDeg, double latDeg, int z, double& px, double& py);
@@ -56,6 +72,10 @@ public:
 signals:
     void cursorInfoChanged(const QString& text);
 
+public slots:
+    // Récupère la dernière photo publiée par le simulateur (ou la relecture)
+    void onSimulationTicked();
+
 protected:
     void paintEvent(QPaintEvent* ev) override;
     void wheelEvent(QWheelEvent* ev) override;
@@ -68,6 +88,41 @@ protected:
 private:
     // --
     Simulator* m_simulator = nullptr;
+    TraceReplay* m_replay = nullptr;
+    SnapshotSource* m_source = nullptr;    // m_simulator ou m_replay
+
+    void detachSource();
+
+    // ---- Interpolation des véhicules ----
+    struct FrameVehicle {
+        int id;
+        QPointF pt;     // position écran interpolée
+        double lat;
+        double range;
+    };
+    static constexpr int kDefaultRenderIntervalMs = 16;  // ~60 FPS
+
+    QTimer m_renderTimer;
+    QElapsedTimer m_frameClock;
+    std::shared_ptr<const SimulationSnapshot> m_prevSnap;
+    std::shared_ptr<const SimulationSnapshot> m_currSnap;
+    QHash<int, int> m_prevIndex;       // id -> index dans m_prevSnap
+    qint64 m_currArrivalMs = 0;        // réception de m_currSnap (horloge m_frameClock)
+    qint64 m_tickPeriodMs = 0;         // intervalle mesuré entre les deux dernières photos
+    double m_lastPaintAlpha = 1.0;
+    std::vector<FrameVehicle> m_frame; // positions de la frame en cours (même ordre que m_currSnap)
+
+    // ---- Carte de densité ----
+    static constexpr int kHeatmapCellPx = 16;
+    RenderMode m_renderMode = RenderMode::Auto;
+    HeatmapQuantity m_heatmapQuantity = HeatmapQuantity::Vehicles;
+    int m_heatmapVehicleThreshold = 5000; // véhicules visibles au-delà desquels on agrège
+    int m_heatmapMaxZoom = 11;            // zoom en dessous duquel (inclus) on agrège
+    std::vector<float> m_heatCounts;      // grille réutilisée d'une frame à l'autre
+
+    // ---- Réseau routier ----
+    RoadLayer m_roadLayer;
+    bool m_showRoadNetwork = true;
 
     // ---- Fallback image ----
     QPixmap m_base;
@@ -75,7 +130,7 @@ private:
     // ---- Tuiles XYZ ----
     QString m_tilesTemplate;
     QNetworkAccessManager m_net;
-    QCache<QString, QPixmap> m_memCache;                   // LRU cache (clé = URL)
+    QCache<TileKey, QPixmap> m_memCache;                   // LRU cache (coût = octets décodés)
     QHash<TileKey, QPointer<QNetworkReply>> m_inflight;    // téléchargements en cours
 
     // ---- Vue ----
@@ -91,13 +146,27 @@ private:
     qint64  m_minRequestIntervalMs = 100;  // ~10 req/s max
     qint64  m_lastRequestMs        = 0;
 
+    static constexpr qint64 kDefaultTileCacheBytes = 192ll * 1024 * 1024;
+
+    // Nombre max de niveaux remontés pour trouver une tuile parente en cache
+    static constexpr int kMaxFallbackDepth = 6;
+
     // ---- Utils ----
 
     static void pixelToLonlat(double px, double py, int z, double& lonDeg, double& latDeg);
     void zoomAt(const QPoint& screenPos, double factor);
     void drawTiles(QPainter& p);
+    void drawFallbackTile(QPainter& p, int z, int x, int y, const QRectF& target);
     void drawHUD(QPainter& p);
+    void onRenderTimer();
+    double interpolationFactor() const;
+    void updateFrame();
+    bool useHeatmap() const;
+    void drawVehicles(QPainter& p);
+    void drawHeatmap(QPainter& p);
     void requestTile(int z,int x,int y);
+    void insertTile(const TileKey& key, QPixmap* px);
+    static qint64 pixmapCost(const QPixmap& px);
     QString buildUrl(int z,int x,int y) const;
     void setCenterWorld(double px, double py, int zoom);
 
@@ -0,0 +1,90 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "graph_types.h"
+
+class RoutePlanner;
+
+/**
+ * @brief Un point de l'espace des paramètres : une simulation indépendante
+ */
+struct SweepPoint {
+    std::string label;
+    int vehicleCount = 100;
+    double speed = 14.0;               // vitesse désirée (m/s)
+    double transmissionRange = 1000.0; // portée (m)
+    double collisionDist = 5.0;
+    bool carFollowing = true;
+    bool eventDriven = false;
+    bool goalDirected = false;         // itinéraires (RoutePlanner) plutôt que marche aléatoire
+    uint32_t seed = 1;                 // positions de départ et choix aléatoires
+    double duration = 600.0;           // temps simulé (s)
+    double warmup = 60.0;              // temps simulé (s) avant le début des mesures
+    double timeStep = 0.5;             // pas fixe (s)
+};
+
+/**
+ * @brief Mesures moyennées sur les pas qui suivent le warmup
+ */
+struct SweepMetrics {
+    SweepPoint point;
+    uint64_t ticks = 0;
+    double simTime = 0.0;
+    double wallSeconds = 0.0;
+    int samples = 0;
+    double meanLinks = 0.0;            // liens directs
+    double meanDegree = 0.0;           // voisins directs par véhicule
+    double meanIsolated = 0.0;         // fraction de véhicules sans voisin
+    double meanComponents = 0.0;       // composantes connexes
+    double meanLargestComponent = 0.0; // fraction de la flotte dans la plus grande composante
+    double meanSpeed = 0.0;            // m/s
+};
+
+/**
+ * @brief Balayage de paramètres en parallèle sur un seul graphe routier
+ *
+ * Le graphe est chargé une fois puis partagé en lecture seule par toutes les
+ * simulations, exécutées sur un QThreadPool (une tâche par point, un
+ * Simulator en ThreadMode::Caller par tâche, pas fixe). Le RoutePlanner
+ * optionnel (et sa hiérarchie de contraction) est lui aussi partagé.
+ */
+class ParameterSweep {
+public:
+    explicit ParameterSweep(const RoadGraph& graph, RoutePlanner* planner = nullptr);
+
+    void addPoint(const SweepPoint& point) { m_points.push_back(point); }
+    const std::vector<SweepPoint>& points() const { return m_points; }
+
+    /**
+     * @brief Produit cartésien portée x taille de flotte x vitesse autour de base
+     */
+    void addGrid(const SweepPoint& base, const std::vector<double>& ranges,
+                 const std::vector<int>& vehicleCounts, const std::vector<double>& speeds);
+
+    /**
+     * @brief Lance tous les points, au plus maxThreads à la fois (0 : tous les cœurs)
+     * @return une mesure par point, dans l'ordre des points
+     */
+    std::vector<SweepMetrics> run(int maxThreads = 0) const;
+
+    // Une simulation complète sur le thread appelant
+    SweepMetrics runPoint(const SweepPoint& point) const;
+
+    /**
+     * @brief Écrit les mesures au format CSV (une ligne par point)
+     * @return false en cas d'erreur d'écriture
+     */
+    static bool writeCsv(const std::string& path, const std::vector<SweepMetrics>& results);
+
+private:
+    const RoadGraph& graph;
+    RoutePlanner* m_planner;
+    std::vector<Vertex> m_spawnVertices;   // sommets avec au moins une route praticable
+    std::vector<SweepPoint> m_points;
+};
+
+#endif // PARAMETER_SWEEP_H
@@ -0,0 +1,193 @@
+#ifndef PROPAGATION_H
+#define PROPAGATION_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "simulation_snapshot.h"
+
+// Modèle de propagation utilisé pour décider des connexions directes
+enum class PropagationModel {
+    UnitDisk,       // disque : distance <= portée des deux véhicules
+    LogDistance,    // affaiblissement log-distance et seuil de sensibilité
+    Shadowing       // log-distance + évanouissement log-normal par paire
+};
+
+// Paramètres radio des modèles à affaiblissement (mêmes radios pour tous les véhicules)
+struct RadioParams {
+    double txPowerDbm = 23.0;           // puissance d'émission
+    double sensitivityDbm = -90.0;      // seuil de réception
+    double referenceLossDb = 47.9;      // affaiblissement à 1 m (5,9 GHz)
+    double exponent = 2.7;              // exposant d'affaiblissement (urbain)
+    double shadowingSigmaDb = 4.0;      // écart-type de l'évanouissement (Shadowing)
+    uint32_t seed = 1;                  // tirage des évanouissements (Shadowing)
+
+    static constexpr double kMaxShadowingSigmaDb = 30.0;
+
+    // Valeurs finies, exposant > 0 et écart-type dans [0, kMaxShadowingSigmaDb]
+    bool isValid() const {
+        return std::isfinite(txPowerDbm) && std::isfinite(sensitivityDbm) && std::isfinite(referenceLossDb) &&
+               std::isfinite(exponent) && exponent > 0.0 &&
+               shadowingSigmaDb >= 0.0 && shadowingSigmaDb <= kMaxShadowingSigmaDb;
+    }
+};
+
+/**
+ * @brief Politiques de propagation, choisies à la compilation
+ *
+ * InterferenceGraph instancie sa boucle sur les paires pour chaque politique :
+ * linked() (lien dans les deux sens) et reaches() (a atteint b, mode orienté)
+ * sont alors intégrés dans la boucle, sans appel virtuel. Les calculs
+ * coûteux (log, pow, quantiles de la loi normale) sont faits à la
+ * construction de la politique ; la boucle ne fait que des lectures de table.
+ *
+ * linkDistance() donne le seuil de distance de la paire : le lien change
+ * d'état quand la distance franchit cette valeur (KineticLinks en déduit
+ * jusqu'à quand un état reste valable).
+ */
+namespace propagation {
+
+class UnitDisk {
+public:
+    explicit UnitDisk(const RadioParams& = RadioParams()) {}
+
+    bool reaches(const VehicleState& a, const VehicleState&, double distance) const {
+        return distance <= a.range;
+    }
+
+    bool linked(const VehicleState& a, const VehicleState& b, double distance) const {
+        return reaches(a, b, distance) && reaches(b, a, distance);
+    }
+
+    double linkDistance(const VehicleState& a, const VehicleState& b) const {
+        return std::min(a.range, b.range);
+    }
+};
+
+/**
+ * Puissance reçue Pt - PL(1 m) - 10 n log10(d) >= sensibilité. La relation
+ * est monotone : elle se réduit à une distance maximale, calculée une fois.
+ * La portée des véhicules est ignorée (elle découle du bilan de liaison).
+ */
+class LogDistance {
+public:
+    explicit LogDistance(const RadioParams& params = RadioParams())
+        : m_maxDistance(std::pow(10.0, (params.txPowerDbm - params.sensitivityDbm - params.referenceLossDb)
+                                       / (10.0 * params.exponent))) {}
+
+    bool linked(const VehicleState&, const VehicleState&, double distance) const {
+        return distance <= m_maxDistance;
+    }
+
+    // Mêmes radios partout : la portée est symétrique
+    bool reaches(const VehicleState& a, const VehicleState& b, double distance) const {
+        return linked(a, b, distance);
+    }
+
+    double linkDistance(const VehicleState&, const VehicleState&) const { return m_maxDistance; }
+
+    double maxDistance() const { return m_maxDistance; }
+
+private:
+    double m_maxDistance;
+};
+
+/**
+ * Log-distance plus un évanouissement X ~ N(0, sigma) propre à chaque paire :
+ * le lien existe si 10 n log10(d) + X <= marge. X est tiré d'un hachage des
+ * deux ids et de la graine : il est identique dans les deux sens, d'un tick à
+ * l'autre et d'une exécution à l'autre.
+ *
+ * Tables : affaiblissement échantillonné tous les kStep mètres (arrondi vers
+ * le bas : erreur < 10 n log10(1 + kStep / d), sous 0,1 dB au-delà de 30 m) et
+ * quantiles de la loi normale, tronquée à 4 sigma ; au-delà de la distance où
+ * même +4 sigma ne suffit plus, aucun lien. Cette distance est bornée à
+ * kMaxDistance, quels que soient les paramètres (taille de la table).
+ */
+class Shadowing {
+public:
+    static constexpr double kStep = 0.5;            // mètres
+    static constexpr int kQuantileBits = 12;
+    static constexpr double kMaxDistance = 20000.0; // mètres
+
+    explicit Shadowing(const RadioParams& params = RadioParams())
+        : m_budget(params.txPowerDbm - params.sensitivityDbm - params.referenceLossDb),
+          m_sigma(params.shadowingSigmaDb),
+          m_seed(params.seed)
+    {
+        // Affaiblissement (hors référence) jusqu'à la distance limite, 1 m minimum
+        // (std::min garde kMaxDistance si le calcul donne NaN)
+        const double maxLoss = m_budget + 4.0 * m_sigma;
+        const double maxDistance = std::min(kMaxDistance, std::pow(10.0, maxLoss / (10.0 * params.exponent)));
+        const size_t n = size_t(maxDistance / kStep) + 1;
+        m_loss.resize(n);
+        for (size_t k = 0; k < n; ++k) {
+            m_loss[k] = float(10.0 * params.exponent * std::log10(std::max(1.0, k * kStep)));
+        }
+
+        // Quantiles de N(0,1) au centre de chaque intervalle de probabilité
+        const size_t q = size_t(1) << kQuantileBits;
+        m_quantile.resize(q);
+        for (size_t k = 0; k < q; ++k) {
+            m_quantile[k] = float(std::clamp(inverseNormal((k + 0.5) / q), -4.0, 4.0));
+        }
+    }
+
+    bool linked(const VehicleState& a, const VehicleState& b, double distance) const {
+        const size_t k = size_t(distance * (1.0 / kStep));
+        if (k >= m_loss.size()) return false;
+        return m_loss[k] + fading(a, b) <= m_budget;
+    }
+
+    // Premier échantillon de la table où le lien n'existe plus (la table est croissante)
+    double linkDistance(const VehicleState& a, const VehicleState& b) const {
+        const float f = fading(a, b);
+        const auto end = std::partition_point(m_loss.begin(), m_loss.end(),
+                                              [&](float loss) { return loss + f <= m_budget; });
+        return double(end - m_loss.begin()) * kStep;
+    }
+
+    // Évanouissement identique dans les deux sens : la portée est symétrique
+    bool reaches(const VehicleState& a, const VehicleState& b, double distance) const {
+        return linked(a, b, distance);
+    }
+
+private:
+    float fading(const VehicleState& a, const VehicleState& b) const {
+        return float(m_sigma) * m_quantile[pairHash(a.id, b.id) >> (64 - kQuantileBits)];
+    }
+
+    // splitmix64 sur la paire non ordonnée
+    uint64_t pairHash(int id1, int id2) const {
+        const uint64_t lo = uint32_t(std::min(id1, id2));
+        const uint64_t hi = uint32_t(std::max(id1, id2));
+        uint64_t x = (hi << 32 | lo) ^ (uint64_t(m_seed) * 0x9E3779B97F4A7C15ull);
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Quantile de la loi normale centrée réduite (dichotomie sur erfc, hors boucle chaude)
+    static double inverseNormal(double p) {
+        double lo = -8.0, hi = 8.0;
+        for (int i = 0; i < 64; ++i) {
+            const double mid = 0.5 * (lo + hi);
+            if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) lo = mid;
+            else hi = mid;
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    double m_budget;                // Pt - sensibilité - PL(1 m)
+    double m_sigma;
+    uint32_t m_seed;
+    std::vector<float> m_loss;      // 10 n log10(d) tous les kStep mètres
+    std::vector<float> m_quantile;  // quantiles de N(0,1)
+};
+
+} // namespace propagation
+
+#endif // PROPAGATION_H
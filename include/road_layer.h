@@ -0,0 +1,84 @@
+#pragma once
+#include <QPixmap>
+#include <QCache>
+#include <QSize>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "graph_types.h"
+#include "tile_key.h"
+
+class QPainter;
+
+/**
+ * @brief Calque statique du réseau routier, rastérisé par tuile et par zoom
+ *
+ * Chaque tuile 256x256 est dessinée une seule fois (couleur selon le type de
+ * route) puis réutilisée d'une frame à l'autre et pendant les déplacements.
+ * Les segments sont indexés dans une grille fixe (zoom kIndexZoom) pour ne
+ * parcourir que les arêtes proches de la tuile demandée.
+ * Le cache n'est vidé que lorsque le graphe change (setGraph / invalidate).
+ */
+class RoadLayer {
+public:
+    RoadLayer();
+
+    // Change de graphe : reconstruit l'index spatial et vide le cache
+    void setGraph(const RoadGraph* graph);
+
+    // À appeler si le graphe courant a été modifié en place
+    void invalidate();
+
+    // Dessine les tuiles visibles (offset = coin haut-gauche de la vue, en pixels monde au zoom z)
+    void draw(QPainter& p, int z, double offsetX, double offsetY, const QSize& viewport);
+
+    void setCacheBudgetBytes(qint64 bytes);
+
+private:
+    // Classes de routes, de la moins à la plus importante (ordre de dessin)
+    enum RoadClass : uint8_t {
+        Minor = 0,
+        Tertiary,
+        Secondary,
+        Primary,
+        Trunk,
+        Motorway,
+        RoadClassCount
+    };
+
+    struct Segment {
+        double ax, ay;  // extrémités en pixels monde au zoom 0 (monde = 256 px)
+        double bx, by;
+        RoadClass cls;
+    };
+
+    static bool classify(const std::string& type, RoadClass& cls);
+    static uint64_t cellKey(int cx, int cy) { return (uint64_t(uint32_t(cx)) << 32) | uint32_t(cy); }
+
+    void buildIndex();
+    const QPixmap* tile(const TileKey& key);
+    QPixmap renderTile(const TileKey& key);
+    void collectSegments(const TileKey& key, std::vector<uint32_t>& out);
+
+private:
+    // Zoom de la grille d'index : une cellule = une tuile à ce zoom
+    static constexpr int kIndexZoom = 14;
+    // Marge (px) autour de la tuile pour ne pas couper l'épaisseur des traits
+    static constexpr double kTileMarginPx = 8.0;
+    // En dessous de ce zoom, les petites routes ne sont pas dessinées
+    static constexpr int kMinorRoadsMinZoom = 14;
+    static constexpr qint64 kDefaultCacheBytes = 64ll * 1024 * 1024;
+
+    const RoadGraph* m_graph = nullptr;
+
+    std::vector<Segment> m_segments;                              // triés par classe
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;  // cellule -> indices de segments
+
+    QCache<TileKey, QPixmap> m_cache;                             // coût = octets décodés
+
+    // Marquage par génération pour dédoublonner les segments présents dans plusieurs cellules
+    std::vector<uint32_t> m_stamp;
+    uint32_t m_stampGen = 0;
+    std::vector<uint32_t> m_scratch;
+};
@@ -0,0 +1,84 @@
+#ifndef ROUTE_PLANNER_H
+#define ROUTE_PLANNER_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+#include "graph_types.h"
+
+class ContractionHierarchy;
+
+/**
+ * @brief Plus courts chemins sur le réseau routier (A*) avec cache partagé
+ *
+ * L'heuristique est la distance de Haversine (GraphBuilder::distance) jusqu'à
+ * la destination : elle est admissible car la longueur d'une arête est la
+ * distance de Haversine entre ses extrémités. Seules les routes praticables
+ * (Vehicule::isValidRoad) sont parcourues.
+ *
+ * Les itinéraires calculés sont partagés (shared_ptr immuable) via un cache
+ * LRU borné, indexé par (origine, destination) : des milliers de véhicules
+ * sur les mêmes trajets ne relancent pas la recherche. route() peut être
+ * appelée depuis plusieurs threads.
+ *
+ * Si une hiérarchie de contraction est fournie, elle remplace A* pour les
+ * absences du cache (mêmes distances, requêtes de l'ordre de la microseconde).
+ */
+class RoutePlanner {
+public:
+    // Suite de sommets de l'origine à la destination (incluses)
+    using Route = std::shared_ptr<const std::vector<Vertex>>;
+
+    explicit RoutePlanner(const RoadGraph& graph, size_t cacheCapacity = 4096);
+
+    /**
+     * @brief Itinéraire le plus court de origin à destination
+     * @return nullptr si la destination est inaccessible
+     */
+    Route route(Vertex origin, Vertex destination);
+
+    /**
+     * @brief Utilise une hiérarchie de contraction (nullptr : revient à A*)
+     * La hiérarchie doit rester valide tant que le planificateur l'utilise.
+     */
+    void setContractionHierarchy(const ContractionHierarchy* ch);
+    const ContractionHierarchy* getContractionHierarchy() const { return m_ch; }
+
+    void clearCache();
+    size_t cacheHits() const;
+    size_t cacheMisses() const;
+
+    const RoadGraph& getGraph() const { return graph; }
+
+private:
+    /**
+     * @brief Calcul effectif d'un itinéraire (appelé en cas d'absence dans le cache)
+     * @return false si la destination est inaccessible
+     */
+    bool computeRoute(Vertex origin, Vertex destination, std::vector<Vertex>& path) const;
+
+    /**
+     * @brief A* depuis origin vers destination (espace de travail réutilisé par thread)
+     */
+    bool astar(Vertex origin, Vertex destination, std::vector<Vertex>& path) const;
+
+    const RoadGraph& graph;
+    const ContractionHierarchy* m_ch = nullptr;
+
+    static uint64_t key(Vertex origin, Vertex destination) { return (uint64_t(origin) << 32) | uint64_t(uint32_t(destination)); }
+
+    // Cache LRU : la tête de liste est l'entrée la plus récemment utilisée
+    using Entry = std::pair<uint64_t, Route>;
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_lru;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_index;
+    size_t m_capacity;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+
+#endif // ROUTE_PLANNER_H
@@ -0,0 +1,46 @@
+#ifndef SIMULATION_SNAPSHOT_H
+#define SIMULATION_SNAPSHOT_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <memory>
+
+/**
+ * @brief État d'un véhicule tel que vu par le rendu (copie, aucune référence au Vehicule)
+ */
+struct VehicleState {
+    int id;
+    double lat;
+    double lon;
+    double range;   // portée de transmission (mètres)
+};
+
+/**
+ * @brief Photo immuable de la simulation publiée après chaque tick
+ */
+struct SimulationSnapshot {
+    uint64_t tick = 0;       // numéro du tick qui a produit cette photo
+    double simTime = 0.0;    // temps simulé (secondes)
+    std::vector<VehicleState> vehicles;
+
+    // Liens directs, une seule fois par paire (indices dans vehicles, first < second)
+    std::vector<std::pair<int, int>> links;
+
+    // Composante connexe de chaque véhicule (index du représentant dans vehicles) :
+    // deux véhicules de même composante communiquent, directement ou par relais
+    std::vector<int> component;
+};
+
+/**
+ * @brief Fournisseur de photos pour le rendu : simulation en cours ou relecture d'une trace
+ */
+class SnapshotSource {
+public:
+    virtual ~SnapshotSource() = default;
+
+    // Dernière photo publiée, utilisable depuis n'importe quel thread
+    virtual std::shared_ptr<const SimulationSnapshot> snapshot() const = 0;
+};
+
+#endif // SIMULATION_SNAPSHOT_H
@@ -4,19 +4,47 @@
 #include <QObject>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QThread>
 #include <vector>
+#include <queue>
+#include <memory>
+#include <atomic>
+#include <mutex>
 #include <iostream>
+#include <random>
+#include <string>
 
 #include "vehicule.h"
 #include "map_view.h"
 #include "graph_builder.h"
 #include "interference_graph.h"
-
-class Simulator : public QObject {
+#include "edge_occupancy.h"
+#include "car_following.h"
+#include "simulation_snapshot.h"
+#include "route_planner.h"
+#include "trajectory_trace.h"
+#include "mac_simulator.h"
+
+/**
+ * The simulation loop runs on its own thread (a QTimer living in m_thread).
+ * Controls may be called from the GUI thread: they are queued and executed
+ * between two ticks. After each tick an immutable SimulationSnapshot is
+ * published with an atomic pointer swap, so the renderer never waits for
+ * the simulation and vice versa.
+ *
+ * With ThreadMode::Caller no thread is started: controls run immediately on
+ * the calling thread and the simulation is driven with advance() (headless
+ * runs, e.g. ParameterSweep). The road graph is only read, so any number of
+ * simulators may share it across threads.
+ */
+class Simulator : public QObject, public SnapshotSource {
     Q_OBJECT
 
 public:
-    explicit Simulator(RoadGraph& graph, MapView* mapView, QObject* parent = nullptr);
+    enum class ThreadMode { Dedicated, Caller };
+
+    explicit Simulator(const RoadGraph& graph, MapView* mapView, QObject* parent = nullptr,
+                       ThreadMode mode = ThreadMode::Dedicated);
     ~Simulator() override;
 
     // Controls
@@ -24,23 +52,86 @@ public:
     void stop(); // stops and resets timer
     void pause(); // pauses (timer stops but state preserved)
     void resume(); // resumes after pause
-    void stepOnce(); // perform a single simulation
+    void stepOnce(); // perform a single simulation step of one tick interval (queued)
+
+    // Fixed simulated step on the calling thread: ThreadMode::Caller, or while stopped
+    void advance(double deltaSeconds);
 
     //vehicle management
-    void addVehicle(Vehicule* v); // takes ownership
+    void addVehicle(Vehicule* v); // takes ownership (queued to the simulation thread)
     bool removeVehicle(Vehicule* v);
     void clearVehicles();
 
+    // Applied to every vehicle added afterwards (queued, so it is ordered with addVehicle)
+    void setRoutePlanner(RoutePlanner* planner);
+
+    // Packet-level radio layer advanced after each tick on the new interference graph
+    // (queued; nullptr detaches it). Its state is not part of checkpoints.
+    void setMacSimulator(MacSimulator* mac);
+
+    // Link model of the interference graph (queued; see InterferenceGraph::setPropagationModel)
+    void setPropagationModel(PropagationModel model, const RadioParams& params = RadioParams());
+
+    // Keep one-way links and strongly connected components in each generation (queued)
+    void setDirectedLinksEnabled(bool e);
+
+    // Attach per-tick link deltas (added/removed links, merges, splits) to each generation (queued)
+    void setLinkChangeTrackingEnabled(bool e);
+
+    // Re-test vehicle pairs only when their distance certificate expires (queued;
+    // see InterferenceGraph::setKineticLinksEnabled)
+    void setKineticLinksEnabled(bool e, double horizon = 500.0);
+
+    // Seeds the engine used for all random choices of the vehicles (queued)
+    void setSeed(uint32_t seed);
+
+    // Checkpoints: vehicle state, RNG state, tick counter, simulated time and parameters
+    // (car following; propagation model, radio parameters, directed, change-tracking and
+    // kinetic modes of the interference graph)
+    // in a compact binary file. Both run on the simulation thread and block the caller
+    // until done; they can be called while running (between two ticks) or paused.
+    // loadCheckpoint replaces all vehicles (those that followed routes get the current route
+    // planner, see setRoutePlanner) and ends a running recording (a trace only holds increasing
+    // ticks); on failure the simulation is left untouched.
+    // A restored run continues exactly like the saved one only when both are driven by
+    // fixed steps (advance()): timer-driven ticks take their dt from the wall clock.
+    bool saveCheckpoint(const std::string& path);
+    bool loadCheckpoint(const std::string& path);
+
+    // Trajectory recording: the snapshot of every tick is appended to a delta-encoded trace
+    // (see TraceWriter, replayed by TraceReplay). The trace header keeps the propagation model
+    // in force when recording starts. Both block until the simulation thread is done.
+    bool startRecording(const std::string& path, uint32_t chunkFrames = TraceWriter::kDefaultChunkFrames);
+    bool stopRecording(); // writes the seek index
+
     // Simulation parameters
     void setSpeedMultiplier(double m);
     double speedMultiplier() const;
     void setCollisionDetectionEnabled(bool e);
 
-    // Read-only access for rendering / UI
-    const std::vector<Vehicule*>& vehicles() const { return m_vehicles; }
+    // Car-following (IDM): when enabled, speeds follow the leader on the same or next edge
+    // and replace the multiplicative slow-down of avoidCollision
+    void setCarFollowingEnabled(bool e);
+    void setIdmParams(const IdmParams& params); // queued to the simulation thread
 
-    // Access to interference graph for visualization
+    // Event-driven advancement: each vehicle only costs work when it reaches a vertex.
+    // Positions are computed from the edge entry time when queried. Speeds are constant
+    // between events, so car-following and collision avoidance are not applied in this mode:
+    // every vehicle drives at its desired speed.
+    void setEventDrivenEnabled(bool e); // queued to the simulation thread
+
+    // Live state: only safe from the simulation thread or while the simulation is stopped.
+    // Rendering / UI must use snapshot() instead.
+    const std::vector<Vehicule*>& vehicles() const { return m_vehicles; }
     const InterferenceGraph& interferenceGraph() const { return m_interferenceGraph; }
+    const EdgeOccupancy& edgeOccupancy() const { return m_occupancy; }
+
+    // Positions and links published at the end of the last tick, safe from any thread
+    // (renderer interpolates between two of them)
+    std::shared_ptr<const SimulationSnapshot> snapshot() const override { return std::atomic_load(&m_snapshot); }
+    // Tick counter and simulated time of that snapshot (0 before the first one)
+    uint64_t tickCount() const { auto snap = snapshot(); return snap ? snap->tick : 0; }
+    double simulationTime() const { auto snap = snapshot(); return snap ? snap->simTime : 0.0; }
 
    const RoadGraph& getGraph() const {return graph;}
 
@@ -60,23 +151,79 @@ public slots:
 
 
 private:
-    // Internal step logic: advances all vehicles by deltaTime
+    // Internal step logic: advances all vehicles by deltaTime, rebuilds links, publishes
     void updateSimulation(double deltaSeconds);
 
+    // IDM step: gathers gaps into m_idm, computes accelerations in one pass, updates speeds
+    void applyCarFollowing(double deltaSeconds);
+
+    // Event-driven mode: processes every vertex arrival up to m_simTime + deltaSeconds
+    void advanceEvents(double deltaSeconds);
+    void scheduleArrival(int i, double now);
+    void enterEventMode(int i);
+
+    // Leader of vehicle i on its edge, or on the edge it will take next
+    bool findLeader(int i, double& gap, double& leaderSpeed);
+
+    // Copies vehicle positions and links into a snapshot and publishes it atomically
+    void publishSnapshot();
+    std::shared_ptr<SimulationSnapshot> acquireSnapshotBuffer();
+
+    bool writeCheckpoint(std::ostream& out) const;
+    bool readCheckpoint(std::istream& in, const std::string& path);
+
+    // Executes f on the simulation thread (queued)
+    template <typename F>
+    void runInSimulationThread(F&& f);
+
+    // Executes f on the simulation thread and waits for it
+    template <typename F>
+    void runInSimulationThreadAndWait(F&& f);
+
 private:
     const RoadGraph& graph;
     MapView* m_mapView;
 
-    QTimer* m_timer;
+    QThread m_thread;           // simulation thread
+    QTimer* m_timer;            // lives in m_thread
     QElapsedTimer m_elapsed;    //to compute deltaTime between ticks (tick = update)
     int m_tickIntervalMs = 50;  //evry 50 ms
-    double m_speedMultiplier = 1.0;
+    std::atomic<double> m_speedMultiplier{1.0};
     bool m_running = false;
     bool m_paused = false;
-    bool m_collisionDetectionEnabled = true;
+    std::atomic<bool> m_collisionDetectionEnabled{true};
+    std::atomic<bool> m_carFollowingEnabled{true};
+    IdmParams m_idmParams;
+    IdmState m_idm;             // per-vehicle arrays, reused every tick
+
+    // Event-driven mode: (arrival time, vehicle index), earliest first
+    using ArrivalEvent = std::pair<double, int>;
+    bool m_eventDriven = false;
+    std::priority_queue<ArrivalEvent, std::vector<ArrivalEvent>, std::greater<ArrivalEvent>> m_arrivals;
+    static constexpr double kStuckRetrySeconds = 1.0;   // vehicle with no valid edge
+    static constexpr double kMinEventDelay = 1e-3;      // guards against zero-length edges
+
+    std::mt19937 m_rng;                     // every random choice of the vehicles
+    RoutePlanner* m_routePlanner = nullptr; // given to added / restored vehicles
+    MacSimulator* m_mac = nullptr;          // advanced over each tick, owned by the caller
+
+    uint64_t m_tick = 0;        // number of ticks performed
+    double m_simTime = 0.0;     // simulated seconds
 
     std::vector<Vehicule*> m_vehicles;
     InterferenceGraph m_interferenceGraph;
+    EdgeOccupancy m_occupancy;  // vehicles per directed edge, ordered by position
+    std::shared_ptr<const SimulationSnapshot> m_snapshot;   // accessed with std::atomic_load/store
+    TraceWriter m_trace;        // open while recording
+
+    // Snapshot buffers handed back by the last reader (custom deleter, any thread) and
+    // reused by the simulation thread; shared so that late releases outlive the simulator
+    struct SnapshotPool {
+        static constexpr size_t kMaxFree = 4;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<SimulationSnapshot>> free;
+    };
+    std::shared_ptr<SnapshotPool> m_snapshotPool = std::make_shared<SnapshotPool>();
 };
 
 
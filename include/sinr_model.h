@@ -0,0 +1,139 @@
+#ifndef SINR_MODEL_H
+#define SINR_MODEL_H
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+#include "interference_graph.h"
+#include "propagation.h"
+
+// Paramètres du modèle SINR (en plus de RadioParams : puissance, affaiblissement)
+struct SinrParams {
+    double noiseDbm = -99.0;        // bruit thermique sur 10 MHz
+    double thresholdDb = 5.0;       // SINR minimal pour décoder
+    double cellSize = 250.0;        // mètres, côté d'une cellule d'agrégation
+    int nearCells = 2;              // cellules voisines sommées exactement (rayon, en cellules)
+};
+
+/**
+ * @brief Liens utilisables dans un slot compte tenu des émetteurs simultanés
+ *
+ * Le graphe d'interférence donne les liens candidats (portée, modèle de
+ * propagation). Pour un ensemble d'émetteurs actifs dans un même slot, un
+ * lien émetteur -> voisin n'est utilisable que si, au récepteur,
+ *     SINR = S / (bruit + somme des autres émetteurs) >= seuil
+ * (affaiblissement log-distance de RadioParams, sans évanouissement). Un
+ * récepteur qui émet lui-même n'entend rien.
+ *
+ * L'interférence est agrégée par cellule carrée : les émetteurs des
+ * cellules proches du récepteur (nearCells) sont sommés un à un ; au-delà,
+ * une cellule compte pour sa puissance totale placée à son barycentre
+ * (pondéré par la puissance). Les cellules sont regroupées par niveaux
+ * (côté doublé d'un niveau à l'autre) : à chaque niveau, seules les cellules
+ * hors du voisinage du récepteur dont la parente est dans le voisinage sont
+ * sommées (liste d'interaction, comme une méthode multipôle réduite au
+ * barycentre). Une cellule lointaine est ainsi vue d'autant plus grossièrement
+ * qu'elle est loin, sous le même angle (côté / distance <= 1 / nearCells).
+ *
+ * Cette part lointaine est calculée une fois par cellule de récepteur, avec
+ * un gain tabulé (pas de pow). La puissance totale reçue est calculée une
+ * fois par récepteur ; l'interférence d'un lien en est déduite en retirant le
+ * signal utile. Coût : récepteurs x émetteurs proches + cellules de
+ * récepteur x niveaux x (2 (2 nearCells + 1))², au lieu de récepteurs x
+ * émetteurs ; le nombre de niveaux croît comme le logarithme de l'étendue.
+ *
+ * Non thread-safe (tampons réutilisés) : une instance par thread.
+ */
+class SinrModel {
+public:
+    struct Stats {
+        long candidates = 0;        // liens émetteur -> voisin examinés
+        long usable = 0;
+        long halfDuplex = 0;        // récepteur lui-même en émission
+        double sumSinrDb = 0.0;     // sur les liens utilisables
+
+        double usableRatio() const { return candidates ? double(usable) / candidates : 0.0; }
+        double meanSinrDb() const { return usable ? sumSinrDb / usable : 0.0; }
+    };
+
+    explicit SinrModel(const RadioParams& radio = RadioParams(), const SinrParams& params = SinrParams());
+
+    /**
+     * @brief Liens utilisables pour ce slot
+     * @param transmitterIds véhicules qui émettent simultanément
+     * @param usable paires (émetteur, récepteur) décodées, par émetteur
+     * @return bilan du slot
+     */
+    Stats evaluate(const InterferenceGraph::Generation& gen, const std::vector<int>& transmitterIds,
+                   std::vector<std::pair<int, int>>& usable);
+
+    /**
+     * @brief SINR (dB) au récepteur pour l'émetteur donné, dans le dernier slot évalué
+     * (calcul exact sur tous les émetteurs, pour contrôle)
+     */
+    double exactSinrDb(const InterferenceGraph::Generation& gen, int transmitterId, int receiverId) const;
+
+private:
+    static constexpr int kMaxLevels = 64;
+    static constexpr int kGainSteps = 256;      // pas de la table de gain par octave de d²
+
+    struct Cell {
+        int64_t cx, cy;
+        double power = 0.0;         // somme des puissances émises (mW)
+        double x = 0.0, y = 0.0;    // barycentre pondéré
+        int begin = 0, end = 0;     // émetteurs de la cellule dans m_cellMembers (niveau 0)
+    };
+
+    // Cellules occupées d'un niveau (niveau L : côté cellSize * 2^L)
+    struct Level {
+        std::vector<Cell> cells;
+        std::unordered_map<uint64_t, int> index;
+    };
+
+    void bind(const InterferenceGraph::Generation& gen);
+    double gain(double dx, double dy) const;
+    // gain() tabulé en fonction de d² (écart relatif ~ n x 0,2 %), pour les cellules agrégées
+    double farGain(double dx, double dy) const;
+    void buildLevels();
+    static uint64_t cellKey(int64_t cx, int64_t cy) { return uint64_t(uint32_t(cx)) << 32 | uint32_t(cy); }
+    int64_t cellCoord(double v) const;
+
+    // Puissance totale reçue par l'index receiver (tous émetteurs, calculée une fois par slot) :
+    // émetteurs des cellules proches un à un, cellules lointaines agrégées
+    double receivedPower(int receiver);
+    // Même total, sans la part de l'émetteur utile
+    double interference(int receiver, int transmitter, double signal);
+    double farPower(int64_t cx, int64_t cy);
+    // Cellule de niveau où la cellule (niveau 0) de l'émetteur est agrégée vue de (cx, cy)
+    const Cell& farAggregate(const Cell& own, int64_t cx, int64_t cy) const;
+    bool isNear(const Cell& cell, int64_t cx, int64_t cy, int level = 0) const;
+
+    RadioParams m_radio;
+    SinrParams m_params;
+    double m_txPower;               // mW
+    double m_noise;                 // mW
+    double m_threshold;             // rapport linéaire
+    double m_refGain;               // 10^(-PL(1 m) / 10)
+    std::vector<float> m_gainTable; // gain par octave de d² et fraction de la mantisse
+
+    // Génération des tampons ci-dessous (adresse et époque)
+    const InterferenceGraph::Generation* m_gen = nullptr;
+    uint64_t m_epoch = 0;
+
+    // Slot courant
+    std::vector<int> m_transmitters;            // indices denses
+    std::vector<uint32_t> m_txStamp;            // = m_slot si l'index émet
+    std::vector<int> m_txRank;                  // index -> rang dans m_transmitters
+    std::vector<uint32_t> m_rxStamp;            // = m_slot si m_rxPower est à jour
+    std::vector<double> m_rxPower;
+    uint32_t m_slot = 0;
+    std::vector<Level> m_levels;                // [0] : cellules de côté cellSize
+    int m_topLevel = 0;
+    std::vector<int> m_cellMembers;
+    std::vector<int> m_cellOfTx;                // émetteur (rang) -> cellule
+    std::unordered_map<uint64_t, double> m_farCache;   // cellule de récepteur -> part lointaine
+};
+
+#endif // SINR_MODEL_H
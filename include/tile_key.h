@@ -0,0 +1,13 @@
+#pragma once
+#include <QHash>
+
+// Identifiant d'une tuile XYZ (Web Mercator, tuiles de 256 px)
+struct TileKey {
+    int z;
+    int x;
+    int y;
+    bool operator==(const TileKey& o) const noexcept { return z==o.z && x==o.x && y==o.y; }
+};
+inline uint qHash(const TileKey &k, uint seed=0) noexcept {
+    return qHash((k.z*73856093) ^ (k.x*19349663) ^ (k.y*83492791), seed);
+}
@@ -0,0 +1,64 @@
+#ifndef TRACE_REPLAY_H
+#define TRACE_REPLAY_H
+
+#include <QObject>
+#include <QTimer>
+#include <QString>
+#include <memory>
+#include <atomic>
+
+#include "simulation_snapshot.h"
+#include "trajectory_trace.h"
+#include "interference_graph.h"
+
+/**
+ * Relecture d'une trace enregistrée par Simulator::startRecording, sans
+ * simulation : chaque tick relu reconstruit le graphe d'interférence à partir
+ * des positions, sous le modèle de propagation enregistré dans la trace, et
+ * publie une SimulationSnapshot, comme le simulateur, ce qui
+ * permet de la donner à MapView (setReplay) ou d'analyser la connectivité.
+ *
+ * Tout se passe dans le thread de l'objet (le décodage d'une frame est
+ * incrémental) ; snapshot() reste utilisable depuis n'importe quel thread.
+ */
+class TraceReplay : public QObject, public SnapshotSource {
+    Q_OBJECT
+
+public:
+    explicit TraceReplay(QObject* parent = nullptr);
+
+    bool open(const QString& path);
+    void close();
+
+    // Lecture : ticksPerStep ticks de la trace toutes les tickIntervalMs
+    void play(int tickIntervalMs = 50, int ticksPerStep = 1);
+    void pause();
+    bool isPlaying() const { return m_timer.isActive(); }
+
+    // Accès direct à un tick (sans décoder la trace depuis le début)
+    bool seek(uint64_t tick);
+
+    uint64_t currentTick() const { return m_tick; }
+    uint64_t firstTick() const { return m_reader.firstTick(); }
+    uint64_t lastTick() const { return m_reader.lastTick(); }
+
+    std::shared_ptr<const SimulationSnapshot> snapshot() const override { return std::atomic_load(&m_snapshot); }
+    const InterferenceGraph& interferenceGraph() const { return m_interferenceGraph; }
+
+signals:
+    // Même signal que Simulator::ticked : temps simulé écoulé depuis la photo précédente
+    void ticked(double deltaTimeSeconds);
+    void finished();
+
+private:
+    void onTimer();
+
+    QTimer m_timer;
+    int m_ticksPerStep = 1;
+    TraceReader m_reader;
+    InterferenceGraph m_interferenceGraph;
+    uint64_t m_tick = 0;
+    std::shared_ptr<const SimulationSnapshot> m_snapshot;   // accessed with std::atomic_load/store
+};
+
+#endif // TRACE_REPLAY_H
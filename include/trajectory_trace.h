@@ -0,0 +1,140 @@
+#ifndef TRAJECTORY_TRACE_H
+#define TRAJECTORY_TRACE_H
+
+#include <QFile>
+#include <QString>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+
+#include "simulation_snapshot.h"
+#include "propagation.h"
+
+/**
+ * @brief Trace binaire des trajectoires (une frame par tick)
+ *
+ * Format :
+ *  - en-tête : "V2VTRACE", version, nombre de frames par bloc, modèle de
+ *    propagation et paramètres radio de l'enregistrement ;
+ *  - blocs : { nbFrames, octets, premier tick, dernier tick } puis les frames.
+ *    Chaque frame stocke le tick (écart au précédent), le temps simulé et,
+ *    pour chaque véhicule, id / lat / lon / portée quantifiés (1e-7 degré,
+ *    centimètre) en varint zigzag, par différence avec le véhicule de même
+ *    rang dans la frame précédente. La première frame d'un bloc est codée
+ *    par rapport à zéro : un bloc se décode sans rien lire avant lui ;
+ *  - index : { premier tick, dernier tick, position } par bloc, suivi d'un
+ *    pied de page. Une trace interrompue (pas d'index) est réindexée en
+ *    parcourant les en-têtes de blocs.
+ *
+ * Les liens ne sont pas enregistrés : ils se recalculent à partir des
+ * positions (InterferenceGraph::buildGraph sur les VehicleState), avec le
+ * modèle de propagation de l'en-tête. Une paire à moins d'un centimètre de
+ * la limite de portée peut donc basculer.
+ */
+class TraceWriter {
+public:
+    static constexpr uint32_t kDefaultChunkFrames = 64;
+
+    ~TraceWriter();
+
+    /**
+     * @brief Crée le fichier (écrase l'existant)
+     * @param chunkFrames frames par bloc : intervalle de l'index de recherche
+     * @param model, radio modèle de propagation sous lequel les liens ont été calculés
+     */
+    bool open(const std::string& path, uint32_t chunkFrames = kDefaultChunkFrames,
+              PropagationModel model = PropagationModel::UnitDisk, const RadioParams& radio = RadioParams());
+
+    // Ajoute la photo d'un tick ; false (rien n'est écrit) si le tick ne suit pas le précédent
+    bool append(const SimulationSnapshot& snap);
+
+    // Vide le bloc en cours, écrit l'index et ferme le fichier
+    bool close();
+
+    bool isOpen() const { return m_out.is_open(); }
+
+private:
+    bool flushChunk();
+
+    struct IndexEntry {
+        uint64_t firstTick;
+        uint64_t lastTick;
+        uint64_t offset;
+    };
+
+    std::ofstream m_out;
+    std::string m_path;
+    uint32_t m_chunkFrames = kDefaultChunkFrames;
+
+    // Bloc en cours, encodé en mémoire
+    std::string m_chunk;
+    uint32_t m_chunkFrameCount = 0;
+    uint64_t m_chunkFirstTick = 0;
+    uint64_t m_lastTick = 0;
+    std::vector<int64_t> m_prev;       // valeurs quantifiées de la frame précédente (4 par véhicule)
+    std::vector<IndexEntry> m_index;
+};
+
+/**
+ * @brief Lecture d'une trace projetée en mémoire (QFile::map)
+ *
+ * Accès direct à n'importe quel tick : recherche dichotomique dans l'index,
+ * puis décodage du bloc à partir de sa première frame. Une lecture séquentielle
+ * reprend là où la précédente s'est arrêtée (une frame décodée par tick).
+ */
+class TraceReader {
+public:
+    ~TraceReader();
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    bool isEmpty() const { return m_chunks.empty(); }
+    uint64_t firstTick() const { return m_chunks.empty() ? 0 : m_chunks.front().firstTick; }
+    uint64_t lastTick() const { return m_chunks.empty() ? 0 : m_chunks.back().lastTick; }
+
+    // Modèle de propagation de l'enregistrement
+    PropagationModel propagationModel() const { return m_model; }
+    const RadioParams& radioParams() const { return m_radio; }
+
+    /**
+     * @brief Frame du tick demandé (ou du dernier tick enregistré avant lui)
+     * @param out vehicles, tick et simTime remplis ; links et component vidés
+     * @return false si la trace est vide, si tick précède le premier tick ou si le bloc est corrompu
+     */
+    bool readFrame(uint64_t tick, SimulationSnapshot& out);
+
+private:
+    struct Chunk {
+        uint64_t firstTick;
+        uint64_t lastTick;
+        uint64_t offset;        // en-tête du bloc
+        uint32_t frameCount;
+        uint32_t payloadBytes;
+    };
+
+    bool loadIndex();
+    bool scanChunks();
+    bool readChunkHeader(uint64_t offset, Chunk& chunk) const;
+
+    // Décode la frame suivante du curseur dans m_cursorFrame
+    bool decodeNextFrame();
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    uint64_t m_size = 0;
+    std::vector<Chunk> m_chunks;
+    PropagationModel m_model = PropagationModel::UnitDisk;
+    RadioParams m_radio;
+
+    // Curseur de décodage : bloc, position de la frame suivante et dernière frame décodée
+    int m_cursorChunk = -1;
+    uint32_t m_cursorFramesRead = 0;
+    uint64_t m_cursorPos = 0;
+    std::vector<int64_t> m_cursorPrev;
+    SimulationSnapshot m_cursorFrame;
+};
+
+#endif // TRAJECTORY_TRACE_H
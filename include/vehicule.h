@@ -2,14 +2,34 @@
 #define VEHICULE_H
 
 #include "graph_types.h"
+#include "route_planner.h"
 #include <vector>
 #include <utility>
 #include <cmath>
+#include <random>
+#include <cstdint>
 
 
 class Vehicule {
 
 public:
+    /**
+     * @brief Complete dynamic state of a vehicle (simulation checkpoints).
+     * The graph, route planner, random engine and lazy clock are not part of it
+     * (followsRoute only tells whether a planner must be given back).
+     */
+    struct State {
+        int id = 0;
+        uint32_t start = 0, goal = 0;
+        uint32_t currVertex = 0, nextVertex = 0, previousVertex = 0, plannedNext = 0;
+        double speed = 0.0, desiredSpeed = 0.0, transmissionRange = 0.0, collisionDist = 0.0;
+        double positionOnEdge = 0.0, edgeLength = 0.0, edgeEntryTime = 0.0;
+        bool hasPlannedNext = false;
+        bool destReached = false;
+        bool followsRoute = false;     ///< Had a route planner (goal-directed driving)
+        std::vector<uint32_t> route;   ///< Remaining route, from the vertex being driven to
+    };
+
     Vehicule(int id, const RoadGraph& graph, Vertex start, Vertex goal, double speed,
              double range, double collisionDist);
 
@@ -22,9 +42,11 @@ public:
     void update(double deltaTime);
 
     /**
-     * @brief Reduces speed if any neighbor is too close (collision avoidance).
+     * @brief Reduces speed if the vehicle ahead on the same edge is too close (collision avoidance),
+     * otherwise recovers toward desiredSpeed.
+     * @param gapToLeader Distance to the leader on the same directed edge (EdgeOccupancy).
      */
-    void avoidCollision();
+    void avoidCollision(double gapToLeader);
     void printStatus() const;
 
     /**
@@ -32,7 +54,7 @@ public:
      * @param from Another vehicle to measure distance from.
      * @return Euclidean distance between vehicles.
      */
-    double calculateDist(Vehicule from) const;
+    double calculateDist(const Vehicule& from) const;
     std::pair<double, double> getPosition() const;
 
     /**
@@ -47,6 +69,30 @@ public:
      */
     Vertex pickNextEdge();
 
+    /**
+     * @brief Event-driven mode: position is derived from the edge entry time when queried.
+     * @param clock Simulated time (seconds) owned by the simulator, nullptr to go back to update()
+     */
+    void setLazyClock(const double* clock);
+
+    /**
+     * @brief Event-driven mode: simulated time at which the vehicle reaches nextVertex.
+     * Infinite when the vehicle is stopped.
+     */
+    double nextArrivalTime() const;
+
+    /**
+     * @brief Event-driven mode: the vehicle reaches nextVertex at eventTime and takes its next edge.
+     */
+    void arriveAt(double eventTime);
+
+    /**
+     * @brief Vertex the vehicle will head to after reaching nextVertex.
+     * The choice is made once and kept, so that car-following can look one edge ahead.
+     * @return the planned vertex, or nextVertex if there is none (goal, dead end)
+     */
+    Vertex peekNextVertex();
+
     /**
      * @brief checks road validity for car movement/ placement
      * @param the Edge to check, and graph
@@ -69,14 +115,58 @@ public:
     int getId() const { return id; }
     double getTransmissionRange() const { return transmissionRange; }
     const std::vector<Vehicule*>& getNeighbors() const { return neighbors;}
+    double getSpeed() const { return speed; }
+    double getDesiredSpeed() const { return desiredSpeed; }
+    void setSpeed(double v) { speed = v; }
+    double getCollisionDist() const { return collisionDist; }
+
+    // Current directed edge (from -> to) and progress along it
+    bool isOnEdge() const { return edgeLength > 0.0; }
+    Vertex getFromVertex() const { return currVertex; }
+    Vertex getToVertex() const { return nextVertex; }
+    double getPositionOnEdge() const { return lazyClock ? lazyPositionOnEdge() : positionOnEdge; }
+    double getEdgeLength() const { return edgeLength; }
     //setter
     void setTransmissionRange(double range) { transmissionRange = range; }
 
+    /**
+     * @brief Goal-directed driving: follow shortest paths to goal instead of a random walk.
+     * @param planner shared planner (its route cache is shared by all vehicles), nullptr to disable
+     */
+    void setRoutePlanner(RoutePlanner* planner) { this->planner = planner; route.reset(); }
+
+    /**
+     * @brief Random engine used for edge choices (owned by the simulator, so runs are reproducible).
+     * Without one, rand() is used.
+     */
+    void setRandomEngine(std::mt19937* engine) { rng = engine; }
+
+    /**
+     * @brief Captures / restores the dynamic state (see State)
+     * @param lazyClock event-driven clock to attach, edgeEntryTime is kept as is
+     */
+    State saveState() const;
+    void restoreState(const State& state, const double* lazyClock = nullptr);
+
     void addNeighbor(Vehicule* v) { neighbors.push_back(v); }
     void clearNeighbors() { neighbors.clear(); }
 
 
 private:
+    /**
+     * @brief Random valid outgoing edge of `at`, avoiding the edge back to `from` when possible
+     * @return false if `at` has no valid outgoing edge
+     */
+    bool chooseOutEdge(Vertex at, Vertex from, Edge& chosen) const;
+
+    double lazyPositionOnEdge() const;
+
+    /**
+     * @brief Next edge along the planned route to goal (plans it if needed)
+     * @return false without planner, or if goal is unreachable
+     */
+    bool followRoute(Edge& chosen);
+    bool routeValid() const;
 
     int id;
     const RoadGraph& graph;         ///< Reference to shared road graph
@@ -90,6 +180,7 @@ private:
     double collisionDist;
     double transmissionRange;
     double speed;
+    double desiredSpeed;            ///< Free-flow speed (car-following target)
 
     //default values
     Vertex currVertex;
@@ -97,9 +188,18 @@ private:
     double positionOnEdge = 0.0;     ///< Distance along the current edge
     bool destReached = false;
     double slowFactor = 0.8;        ///< Speed reduction factor when avoiding collision
+    Vertex plannedNext = 0;         ///< Hop after nextVertex, see peekNextVertex()
+    bool hasPlannedNext = false;
+
+    // Event-driven mode (lazyClock != nullptr): positionOnEdge is the offset at edgeEntryTime
+    const double* lazyClock = nullptr;
+    double edgeEntryTime = 0.0;
 
     std::vector<Vehicule*> neighbors;
-    std::vector<Vertex> route;      ///< Optional route (sequence of vertices)
+    std::mt19937* rng = nullptr;
+    RoutePlanner* planner = nullptr;
+    RoutePlanner::Route route;      ///< Shared route to goal (sequence of vertices)
+    size_t routeIndex = 0;          ///< Index in route of the vertex being driven to
 };
 
 #endif
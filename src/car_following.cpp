@@ -0,0 +1,39 @@
+#include "car_following.h"
+#include <algorithm>
+#include <cmath>
+
+void IdmState::resize(size_t n) {
+    speed.resize(n);
+    desiredSpeed.resize(n);
+    gap.resize(n);
+    leaderSpeed.resize(n);
+    accel.resize(n);
+}
+
+void computeAccelerations(const IdmParams& params, IdmState& state) {
+    const size_t n = state.speed.size();
+    const double a = params.maxAccel;
+    const double s0 = params.minGap;
+    const double T = params.timeHeadway;
+    const double invSqrtAb = 1.0 / (2.0 * std::sqrt(params.maxAccel * params.comfortDecel));
+
+    const double* v = state.speed.data();
+    const double* v0 = state.desiredSpeed.data();
+    const double* s = state.gap.data();
+    const double* vl = state.leaderSpeed.data();
+    double* acc = state.accel.data();
+
+    for (size_t i = 0; i < n; ++i) {
+        const double ratio = v[i] / std::max(v0[i], 0.1);
+        const double r2 = ratio * ratio;
+        const double freeTerm = r2 * r2;
+
+        const double dv = v[i] - vl[i];
+        const double sStar = s0 + std::max(0.0, v[i] * T + v[i] * dv * invSqrtAb);
+        // s = +inf (route libre) donne un terme d'interaction nul
+        const double q = sStar / std::max(s[i], 0.01);
+        const double interaction = q * q;
+
+        acc[i] = a * (1.0 - freeTerm - interaction);
+    }
+}
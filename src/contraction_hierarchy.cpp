@@ -0,0 +1,484 @@
+#include "contraction_hierarchy.h"
+#include "vehicule.h"
+#include "graph_builder.h"
+#include "binary_io.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <functional>
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// Recherche de témoins bornée : au-delà, un raccourci est ajouté (correct, juste moins économe)
+constexpr size_t kWitnessSettleLimit = 500;
+
+constexpr char kFileMagic[8] = {'V', '2', 'V', 'C', 'H', 0, 0, 0};
+constexpr uint32_t kFileVersion = 1;
+
+using QueueItem = std::pair<double, uint32_t>;
+using MinQueue = std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>>;
+
+// Graphe résiduel pendant la contraction : seuls les voisins non contractés sont conservés
+class Contractor {
+public:
+    struct Shortcut { uint32_t from, to; double weight; };
+
+    explicit Contractor(size_t n)
+        : adj(n), deleted(n, 0), dist(n, kInf), stamp(n, 0) {}
+
+    void addLink(uint32_t u, uint32_t x, double weight, uint32_t middle) {
+        for (auto& l : adj[u]) {
+            if (l.target == x) {
+                if (weight < l.weight) { l.weight = weight; l.middle = middle; }
+                return;
+            }
+        }
+        adj[u].push_back({x, middle, weight});
+    }
+
+    // Raccourcis nécessaires pour contracter v (paires de voisins sans chemin témoin)
+    void shortcuts(uint32_t v, std::vector<Shortcut>& out) {
+        out.clear();
+        const auto& nv = adj[v];
+        for (size_t i = 0; i + 1 < nv.size(); ++i) {
+            double maxCost = 0.0;
+            for (size_t j = i + 1; j < nv.size(); ++j) maxCost = std::max(maxCost, nv[i].weight + nv[j].weight);
+            witnessSearch(nv[i].target, v, maxCost);
+            for (size_t j = i + 1; j < nv.size(); ++j) {
+                const double via = nv[i].weight + nv[j].weight;
+                if (witnessDist(nv[j].target) > via) out.push_back({nv[i].target, nv[j].target, via});
+            }
+        }
+    }
+
+    // Différence d'arêtes + voisins déjà contractés (répartit la contraction sur le graphe)
+    int priority(uint32_t v, const std::vector<Shortcut>& sc) const {
+        return int(sc.size()) - int(adj[v].size()) + deleted[v];
+    }
+
+    // Retire v du graphe résiduel ; ses arcs restants deviennent ses arcs montants
+    void contract(uint32_t v, const std::vector<Shortcut>& sc, std::vector<ContractionHierarchy::Arc>& up) {
+        up = adj[v];
+        for (const auto& l : adj[v]) {
+            auto& na = adj[l.target];
+            na.erase(std::remove_if(na.begin(), na.end(),
+                                    [v](const ContractionHierarchy::Arc& a) { return a.target == v; }),
+                     na.end());
+            ++deleted[l.target];
+        }
+        for (const auto& s : sc) {
+            addLink(s.from, s.to, s.weight, v);
+            addLink(s.to, s.from, s.weight, v);
+        }
+        std::vector<ContractionHierarchy::Arc>().swap(adj[v]);
+    }
+
+private:
+    // Dijkstra local depuis source sans passer par via, arrêté au-delà de maxCost
+    void witnessSearch(uint32_t source, uint32_t via, double maxCost) {
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        MinQueue open;
+        dist[source] = 0.0;
+        stamp[source] = generation;
+        open.push({0.0, source});
+        size_t settled = 0;
+        while (!open.empty()) {
+            auto [d, u] = open.top();
+            open.pop();
+            if (d > dist[u]) continue;
+            if (d > maxCost || ++settled > kWitnessSettleLimit) break;
+            for (const auto& l : adj[u]) {
+                if (l.target == via) continue;
+                const double nd = d + l.weight;
+                if (stamp[l.target] != generation || nd < dist[l.target]) {
+                    stamp[l.target] = generation;
+                    dist[l.target] = nd;
+                    open.push({nd, l.target});
+                }
+            }
+        }
+    }
+
+    double witnessDist(uint32_t v) const { return stamp[v] == generation ? dist[v] : kInf; }
+
+    std::vector<std::vector<ContractionHierarchy::Arc>> adj;
+    std::vector<int> deleted;
+    std::vector<double> dist;
+    std::vector<uint32_t> stamp;
+    uint32_t generation = 0;
+};
+
+// Espace de travail des requêtes : deux recherches marquées par génération, réutilisé par thread
+struct QueryWorkspace {
+    std::vector<double> dist[2];
+    std::vector<uint32_t> parent[2];
+    std::vector<uint32_t> stamp[2];
+    uint32_t generation = 0;
+
+    // Buckets de distanceTable : (index de cible, distance) par sommet atteint
+    std::vector<std::vector<std::pair<uint32_t, double>>> buckets;
+    std::vector<uint32_t> touched;
+
+    void prepare(size_t n) {
+        if (stamp[0].size() != n) {
+            for (int s = 0; s < 2; ++s) {
+                dist[s].assign(n, kInf);
+                parent[s].assign(n, 0);
+                stamp[s].assign(n, 0);
+            }
+            buckets.assign(n, {});
+            generation = 0;
+        }
+        if (++generation == 0) {
+            std::fill(stamp[0].begin(), stamp[0].end(), 0);
+            std::fill(stamp[1].begin(), stamp[1].end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool seen(int side, uint32_t v) const { return stamp[side][v] == generation; }
+};
+
+// Une instance par thread, partagée par search() et les fonctions qui lisent ses résultats
+QueryWorkspace& workspace() {
+    thread_local QueryWorkspace ws;
+    return ws;
+}
+
+} // namespace
+
+void ContractionHierarchy::build(const RoadGraph& graph) {
+    const size_t n = boost::num_vertices(graph);
+    Contractor contractor(n);
+
+    auto [eStart, eEnd] = boost::edges(graph);
+    for (auto it = eStart; it != eEnd; ++it) {
+        const Edge e = *it;
+        if (!Vehicule::isValidRoad(graph[e].type)) continue;
+        const uint32_t u = uint32_t(boost::source(e, graph));
+        const uint32_t v = uint32_t(boost::target(e, graph));
+        if (u == v) continue;
+        contractor.addLink(u, v, graph[e].distance, kNoMiddle);
+        contractor.addLink(v, u, graph[e].distance, kNoMiddle);
+    }
+
+    // File de priorité à mise à jour paresseuse : la priorité est recalculée à la sortie
+    std::vector<Contractor::Shortcut> sc;
+    std::priority_queue<std::pair<int, uint32_t>, std::vector<std::pair<int, uint32_t>>,
+                        std::greater<std::pair<int, uint32_t>>> queue;
+    for (uint32_t v = 0; v < n; ++v) {
+        contractor.shortcuts(v, sc);
+        queue.push({contractor.priority(v, sc), v});
+    }
+
+    std::vector<std::vector<Arc>> up(n);
+    m_rank.assign(n, 0);
+    m_shortcuts = 0;
+    uint32_t nextRank = 0;
+    while (!queue.empty()) {
+        const uint32_t v = queue.top().second;
+        queue.pop();
+
+        contractor.shortcuts(v, sc);
+        const int p = contractor.priority(v, sc);
+        if (!queue.empty() && p > queue.top().first) {
+            queue.push({p, v});
+            continue;
+        }
+
+        contractor.contract(v, sc, up[v]);
+        m_rank[v] = nextRank++;
+    }
+
+    m_offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; ++v) m_offsets[v + 1] = m_offsets[v] + uint32_t(up[v].size());
+    m_arcs.clear();
+    m_arcs.reserve(m_offsets[n]);
+    for (size_t v = 0; v < n; ++v) {
+        for (const auto& a : up[v]) {
+            if (a.middle != kNoMiddle) ++m_shortcuts;
+            m_arcs.push_back(a);
+        }
+    }
+    m_fingerprint = GraphBuilder::fingerprint(graph);
+}
+
+bool ContractionHierarchy::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Erreur : impossible d'écrire la hiérarchie de contraction " << path << std::endl;
+        return false;
+    }
+    out.write(kFileMagic, sizeof(kFileMagic));
+    writePod(out, kFileVersion);
+    writePod(out, m_fingerprint);
+    writePod(out, uint64_t(m_rank.size()));
+    writePod(out, uint64_t(m_arcs.size()));
+    writePod(out, uint64_t(m_shortcuts));
+    out.write(reinterpret_cast<const char*>(m_rank.data()), m_rank.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(m_offsets.data()), m_offsets.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(m_arcs.data()), m_arcs.size() * sizeof(Arc));
+    if (!out) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ContractionHierarchy::load(const std::string& path, const RoadGraph& graph) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;  // pas encore construite : pas une erreur
+
+    char magic[sizeof(kFileMagic)];
+    uint32_t version = 0;
+    uint64_t print = 0, n = 0, arcs = 0, shortcuts = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kFileMagic) ||
+        !readPod(in, version) || version != kFileVersion) {
+        std::cerr << "Erreur : " << path << " n'est pas une hiérarchie de contraction valide" << std::endl;
+        return false;
+    }
+    if (!readPod(in, print) || !readPod(in, n) || !readPod(in, arcs) || !readPod(in, shortcuts)) {
+        std::cerr << "Erreur : en-tête tronqué dans " << path << std::endl;
+        return false;
+    }
+    if (print != GraphBuilder::fingerprint(graph) || n != boost::num_vertices(graph)) {
+        std::cerr << "Hiérarchie de contraction " << path << " obsolète (graphe modifié)" << std::endl;
+        return false;
+    }
+
+    // Taille annoncée confrontée à celle du fichier avant toute allocation
+    const std::streamoff start = in.tellg();
+    in.seekg(0, std::ios::end);
+    const uint64_t remaining = uint64_t(in.tellg() - start);
+    in.seekg(start);
+    if (arcs > remaining / sizeof(Arc) || remaining != (2 * n + 1) * sizeof(uint32_t) + arcs * sizeof(Arc)) {
+        std::cerr << "Erreur : données tronquées dans " << path << std::endl;
+        return false;
+    }
+
+    std::vector<uint32_t> rank(n), offsets(n + 1);
+    std::vector<Arc> arcList(arcs);
+    in.read(reinterpret_cast<char*>(rank.data()), rank.size() * sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(arcList.data()), arcList.size() * sizeof(Arc));
+    if (!in || !isConsistent(rank, offsets, arcList)) {
+        std::cerr << "Erreur : hiérarchie de contraction corrompue dans " << path << std::endl;
+        return false;
+    }
+
+    m_rank = std::move(rank);
+    m_offsets = std::move(offsets);
+    m_arcs = std::move(arcList);
+    m_shortcuts = size_t(shortcuts);
+    m_fingerprint = print;
+    return true;
+}
+
+bool ContractionHierarchy::isConsistent(const std::vector<uint32_t>& rank, const std::vector<uint32_t>& offsets,
+                                        const std::vector<Arc>& arcs) {
+    const size_t n = rank.size();
+
+    // Rangs : permutation de [0, n)
+    std::vector<char> seen(n, 0);
+    for (uint32_t r : rank) {
+        if (r >= n || seen[r]) return false;
+        seen[r] = 1;
+    }
+
+    // CSR : décalages croissants de 0 au nombre d'arcs
+    if (offsets.front() != 0 || offsets.back() != arcs.size()) return false;
+    for (size_t v = 0; v < n; ++v) {
+        if (offsets[v] > offsets[v + 1]) return false;
+    }
+
+    // Arcs montants ; un raccourci contourne un sommet de rang inférieur à ses deux extrémités,
+    // relié à chacune par un arc (le dépliage récursif se termine et ne sort pas du tableau)
+    auto hasArc = [&](uint32_t a, uint32_t b) {
+        const uint32_t lo = rank[a] < rank[b] ? a : b;
+        const uint32_t hi = lo == a ? b : a;
+        return std::any_of(arcs.begin() + offsets[lo], arcs.begin() + offsets[lo + 1],
+                           [hi](const Arc& arc) { return arc.target == hi; });
+    };
+    for (uint32_t v = 0; v < n; ++v) {
+        for (uint32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+            const Arc& arc = arcs[k];
+            if (arc.target >= n || rank[arc.target] <= rank[v] || !(arc.weight >= 0.0)) return false;
+            if (arc.middle == kNoMiddle) continue;
+            if (arc.middle >= n || rank[arc.middle] >= rank[v] ||
+                !hasArc(v, arc.middle) || !hasArc(arc.middle, arc.target)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const ContractionHierarchy::Arc* ContractionHierarchy::findArc(uint32_t a, uint32_t b) const {
+    const uint32_t lo = m_rank[a] < m_rank[b] ? a : b;
+    const uint32_t hi = lo == a ? b : a;
+    for (const Arc* arc = arcsBegin(lo); arc != arcsEnd(lo); ++arc) {
+        if (arc->target == hi) return arc;
+    }
+    return nullptr;
+}
+
+void ContractionHierarchy::unpack(uint32_t a, uint32_t b, uint32_t middle, std::vector<Vertex>& path) const {
+    if (middle == kNoMiddle) {
+        path.push_back(b);
+        return;
+    }
+    // Les arcs a-middle et middle-b ont été figés à la contraction de middle
+    unpack(a, middle, findArc(a, middle)->middle, path);
+    unpack(middle, b, findArc(middle, b)->middle, path);
+}
+
+uint32_t ContractionHierarchy::search(uint32_t origin, uint32_t destination, double& best) const {
+    const uint32_t n = uint32_t(m_rank.size());
+    best = kInf;
+    if (origin >= n || destination >= n) return n;
+
+    QueryWorkspace& ws = workspace();
+    ws.prepare(n);
+
+    MinQueue open[2];
+    const uint32_t ends[2] = {origin, destination};
+    for (int s = 0; s < 2; ++s) {
+        ws.dist[s][ends[s]] = 0.0;
+        ws.parent[s][ends[s]] = ends[s];
+        ws.stamp[s][ends[s]] = ws.generation;
+        open[s].push({0.0, ends[s]});
+    }
+
+    uint32_t meet = n;
+    while (!open[0].empty() || !open[1].empty()) {
+        // Côté dont la file a le plus petit minimum ; arrêt dès qu'il dépasse la meilleure distance
+        const int s = open[1].empty() || (!open[0].empty() && open[0].top().first <= open[1].top().first) ? 0 : 1;
+        auto [d, u] = open[s].top();
+        if (d >= best) break;
+        open[s].pop();
+        if (d > ws.dist[s][u]) continue;
+
+        if (ws.seen(1 - s, u) && d + ws.dist[1 - s][u] < best) {
+            best = d + ws.dist[1 - s][u];
+            meet = u;
+        }
+
+        for (const Arc* a = arcsBegin(u); a != arcsEnd(u); ++a) {
+            const double nd = d + a->weight;
+            if (!ws.seen(s, a->target) || nd < ws.dist[s][a->target]) {
+                ws.stamp[s][a->target] = ws.generation;
+                ws.dist[s][a->target] = nd;
+                ws.parent[s][a->target] = u;
+                open[s].push({nd, a->target});
+            }
+        }
+    }
+    return meet;
+}
+
+double ContractionHierarchy::distance(Vertex origin, Vertex destination) const {
+    if (origin == destination) return 0.0;
+    double best;
+    search(uint32_t(origin), uint32_t(destination), best);
+    return best;
+}
+
+bool ContractionHierarchy::route(Vertex origin, Vertex destination, std::vector<Vertex>& path) const {
+    path.clear();
+    if (origin >= m_rank.size() || destination >= m_rank.size()) return false;
+    if (origin == destination) {
+        path.push_back(origin);
+        return true;
+    }
+
+    double best;
+    const uint32_t meet = search(uint32_t(origin), uint32_t(destination), best);
+    if (meet == m_rank.size()) return false;
+    const QueryWorkspace& ws = workspace();
+
+    // Chemin montant origine -> rencontre (remonté par les parents avant, puis inversé)
+    std::vector<uint32_t> hops;
+    for (uint32_t v = meet; v != uint32_t(origin); v = ws.parent[0][v]) hops.push_back(v);
+    hops.push_back(uint32_t(origin));
+    std::reverse(hops.begin(), hops.end());
+    // puis rencontre -> destination par les parents arrière
+    for (uint32_t v = meet; v != uint32_t(destination);) {
+        v = ws.parent[1][v];
+        hops.push_back(v);
+    }
+
+    path.push_back(origin);
+    for (size_t i = 0; i + 1 < hops.size(); ++i) {
+        unpack(hops[i], hops[i + 1], findArc(hops[i], hops[i + 1])->middle, path);
+    }
+    return true;
+}
+
+std::vector<double> ContractionHierarchy::distanceTable(const std::vector<Vertex>& sources,
+                                                        const std::vector<Vertex>& targets) const {
+    std::vector<double> table(sources.size() * targets.size(), kInf);
+    const uint32_t n = uint32_t(m_rank.size());
+    if (table.empty() || n == 0) return table;
+
+    QueryWorkspace& ws = workspace();
+
+    // Recherche montante complète depuis v (côté side), visit(sommet, distance) sur chaque sommet fixé
+    auto upward = [&](uint32_t v, int side, const std::function<void(uint32_t, double)>& visit) {
+        MinQueue open;
+        ws.dist[side][v] = 0.0;
+        ws.stamp[side][v] = ws.generation;
+        open.push({0.0, v});
+        while (!open.empty()) {
+            auto [d, u] = open.top();
+            open.pop();
+            if (d > ws.dist[side][u]) continue;
+            visit(u, d);
+            for (const Arc* a = arcsBegin(u); a != arcsEnd(u); ++a) {
+                const double nd = d + a->weight;
+                if (!ws.seen(side, a->target) || nd < ws.dist[side][a->target]) {
+                    ws.stamp[side][a->target] = ws.generation;
+                    ws.dist[side][a->target] = nd;
+                    open.push({nd, a->target});
+                }
+            }
+        }
+    };
+
+    // 1. Recherches arrière : chaque cible dépose sa distance dans les buckets de son espace de recherche
+    for (uint32_t j = 0; j < targets.size(); ++j) {
+        if (targets[j] >= n) continue;
+        ws.prepare(n);
+        upward(uint32_t(targets[j]), 1, [&](uint32_t u, double d) {
+            if (ws.buckets[u].empty()) ws.touched.push_back(u);
+            ws.buckets[u].push_back({j, d});
+        });
+    }
+
+    // 2. Recherches avant : chaque sommet fixé combine sa distance avec les buckets
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] >= n) continue;
+        ws.prepare(n);
+        double* row = table.data() + i * targets.size();
+        upward(uint32_t(sources[i]), 0, [&](uint32_t u, double d) {
+            for (const auto& [j, dt] : ws.buckets[u]) row[j] = std::min(row[j], d + dt);
+        });
+    }
+
+    for (uint32_t u : ws.touched) ws.buckets[u].clear();
+    ws.touched.clear();
+    return table;
+}
+
+void ContractionHierarchy::printSummary() const {
+    std::cout << "Hiérarchie de contraction :" << std::endl;
+    std::cout << "  Sommets        : " << m_rank.size() << std::endl;
+    std::cout << "  Arcs montants  : " << m_arcs.size() << std::endl;
+    std::cout << "  dont raccourcis: " << m_shortcuts << std::endl;
+}
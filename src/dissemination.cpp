@@ -0,0 +1,150 @@
+#include "dissemination.h"
+
+#include <algorithm>
+
+DisseminationEngine::DisseminationEngine(Mode mode, double slotSeconds)
+    : m_mode(mode), m_slotSeconds(slotSeconds) {}
+
+uint32_t DisseminationEngine::slotOf(int vehicleId) {
+    auto it = m_slotOf.find(vehicleId);
+    if (it != m_slotOf.end()) return it->second;
+
+    uint32_t slot = uint32_t(m_vehicleOf.size());
+    m_slotOf.emplace(vehicleId, slot);
+    m_vehicleOf.push_back(vehicleId);
+    m_slotToIndex.push_back(-1);
+    return slot;
+}
+
+void DisseminationEngine::bindGeneration(const InterferenceGraph::Generation& gen) {
+    // Même génération qu'au slot précédent : correspondances déjà à jour
+    if (m_gen == &gen && m_boundEpoch == gen.epoch()) return;
+
+    // Efface l'ancienne correspondance numéro -> index
+    if (m_gen) {
+        for (uint32_t slot : m_indexToSlot) {
+            m_slotToIndex[slot] = -1;
+        }
+    }
+
+    int n = gen.vehicleCount();
+    m_indexToSlot.resize(n);
+    for (int i = 0; i < n; ++i) {
+        uint32_t slot = slotOf(gen.idAt(i));
+        m_indexToSlot[i] = slot;
+        m_slotToIndex[slot] = i;
+    }
+
+    m_gen = &gen;
+    m_boundEpoch = gen.epoch();
+}
+
+bool DisseminationEngine::testAndSet(Message& msg, uint32_t slot) {
+    size_t word = slot >> 6;
+    uint64_t bit = uint64_t(1) << (slot & 63);
+
+    if (word >= msg.seen.size()) {
+        // Le bitset suit le nombre de véhicules connus (réserve pour éviter les petites croissances)
+        msg.seen.resize(std::max(word + 1, (m_vehicleOf.size() + 63) >> 6), 0);
+    }
+    if (msg.seen[word] & bit) return false;
+    msg.seen[word] |= bit;
+    return true;
+}
+
+int DisseminationEngine::inject(int sourceVehicleId, int hopLimit, uint64_t lifetimeSlots) {
+    Message msg;
+    msg.stats.messageId = int(m_messages.size());
+    msg.stats.sourceId = sourceVehicleId;
+    msg.stats.injectSlot = m_slot;
+    msg.stats.lastDeliverySlot = m_slot;
+    msg.hopLimit = hopLimit;
+    msg.expirySlot = lifetimeSlots ? m_slot + lifetimeSlots : 0;
+
+    uint32_t slot = slotOf(sourceVehicleId);
+    testAndSet(msg, slot);
+    msg.carriers.push_back({slot, 0});
+
+    m_messages.push_back(std::move(msg));
+    m_active.push_back(m_messages.back().stats.messageId);
+    return m_messages.back().stats.messageId;
+}
+
+void DisseminationEngine::transmit(Message& msg) {
+    const InterferenceGraph::Generation& gen = *m_gen;
+
+    // Émetteurs de ce slot : la frontière (Flooding) ou tous les porteurs
+    size_t begin = m_mode == Mode::Flooding ? msg.frontierBegin : 0;
+    size_t end = msg.carriers.size();
+    uint32_t latency = uint32_t(m_slot + 1 - msg.stats.injectSlot);
+
+    for (size_t c = begin; c < end; ++c) {
+        Carrier sender = msg.carriers[c];
+        if (msg.hopLimit != kUnlimitedHops && sender.hops >= msg.hopLimit) continue;
+
+        int index = m_slotToIndex[sender.slot];
+        if (index < 0) {
+            continue;   // véhicule sorti de la simulation
+        }
+
+        uint16_t hops = uint16_t(sender.hops + 1);
+        for (const int* it = gen.neighborsBegin(index); it != gen.neighborsEnd(index); ++it) {
+            uint32_t receiver = m_indexToSlot[*it];
+            if (!testAndSet(msg, receiver)) continue;
+
+            msg.carriers.push_back({receiver, hops});
+            msg.stats.delivered++;
+            msg.stats.sumHops += hops;
+            msg.stats.sumLatencySlots += latency;
+            msg.stats.maxHops = std::max(msg.stats.maxHops, int(hops));
+            msg.stats.lastDeliverySlot = m_slot + 1;
+
+            if (m_recordDeliveries) {
+                m_deliveries.push_back({msg.stats.messageId, m_vehicleOf[receiver], latency, hops});
+            }
+        }
+    }
+
+    msg.frontierBegin = end;
+}
+
+void DisseminationEngine::step(const InterferenceGraph::Generation& gen, int slots) {
+    bindGeneration(gen);
+
+    for (int s = 0; s < slots; ++s) {
+        size_t kept = 0;
+        for (size_t a = 0; a < m_active.size(); ++a) {
+            Message& msg = m_messages[m_active[a]];
+            transmit(msg);
+
+            bool exhausted = m_mode == Mode::Flooding && msg.frontierBegin == msg.carriers.size();
+            bool expired = msg.expirySlot != 0 && m_slot + 1 >= msg.expirySlot;
+
+            if (exhausted || expired) {
+                // Plus aucune émission : seul le bitset reste (hasReceived)
+                msg.stats.active = false;
+                std::vector<Carrier>().swap(msg.carriers);
+                msg.frontierBegin = 0;
+            } else {
+                m_active[kept++] = m_active[a];
+            }
+        }
+        m_active.resize(kept);
+        ++m_slot;
+    }
+}
+
+bool DisseminationEngine::hasReceived(int messageId, int vehicleId) const {
+    auto it = m_slotOf.find(vehicleId);
+    if (it == m_slotOf.end()) return false;
+
+    const std::vector<uint64_t>& seen = m_messages[messageId].seen;
+    size_t word = it->second >> 6;
+    return word < seen.size() && ((seen[word] >> (it->second & 63)) & 1);
+}
+
+void DisseminationEngine::clear() {
+    m_messages.clear();
+    m_active.clear();
+    m_deliveries.clear();
+}
@@ -0,0 +1,83 @@
+#include "edge_occupancy.h"
+#include "vehicule.h"
+
+void EdgeOccupancy::clear() {
+    m_lanes.clear();
+    m_slots.clear();
+}
+
+void EdgeOccupancy::removeFromLane(int vehicleIndex) {
+    Slot& slot = m_slots[vehicleIndex];
+    if (slot.lane == kNoLane) return;
+
+    auto it = m_lanes.find(slot.lane);
+    std::vector<int>& list = it->second;
+    list.erase(list.begin() + slot.pos);
+    for (int k = slot.pos; k < int(list.size()); ++k) m_slots[list[k]].pos = k;
+    if (list.empty()) m_lanes.erase(it);
+
+    slot = Slot();
+}
+
+void EdgeOccupancy::update(const std::vector<Vehicule*>& vehicles) {
+    if (m_slots.size() > vehicles.size()) clear();
+    m_slots.resize(vehicles.size());
+
+    // Étape 1 : déplacer uniquement les véhicules qui ont changé d'arête
+    for (int i = 0; i < int(vehicles.size()); ++i) {
+        const Vehicule* v = vehicles[i];
+        const uint64_t key = (v && v->isOnEdge()) ? laneKey(v->getFromVertex(), v->getToVertex()) : kNoLane;
+        if (key == m_slots[i].lane) continue;
+
+        removeFromLane(i);
+        if (key == kNoLane) continue;
+
+        std::vector<int>& list = m_lanes[key];
+        m_slots[i].lane = key;
+        m_slots[i].pos = int(list.size());
+        list.push_back(i);
+    }
+
+    // Étape 2 : tri par insertion de chaque arête (listes presque triées d'un tick à l'autre)
+    for (auto& [key, list] : m_lanes) {
+        for (int k = 1; k < int(list.size()); ++k) {
+            const int idx = list[k];
+            const double pos = vehicles[idx]->getPositionOnEdge();
+            int j = k - 1;
+            while (j >= 0 && vehicles[list[j]]->getPositionOnEdge() > pos) {
+                list[j + 1] = list[j];
+                --j;
+            }
+            list[j + 1] = idx;
+        }
+        for (int k = 0; k < int(list.size()); ++k) m_slots[list[k]].pos = k;
+    }
+}
+
+int EdgeOccupancy::leaderOf(int vehicleIndex) const {
+    if (vehicleIndex < 0 || vehicleIndex >= int(m_slots.size())) return -1;
+    const Slot& slot = m_slots[vehicleIndex];
+    if (slot.lane == kNoLane) return -1;
+
+    const std::vector<int>& list = m_lanes.at(slot.lane);
+    return slot.pos + 1 < int(list.size()) ? list[slot.pos + 1] : -1;
+}
+
+int EdgeOccupancy::followerOf(int vehicleIndex) const {
+    if (vehicleIndex < 0 || vehicleIndex >= int(m_slots.size())) return -1;
+    const Slot& slot = m_slots[vehicleIndex];
+    if (slot.lane == kNoLane || slot.pos == 0) return -1;
+
+    return m_lanes.at(slot.lane)[slot.pos - 1];
+}
+
+double EdgeOccupancy::gapToLeader(int vehicleIndex, const std::vector<Vehicule*>& vehicles) const {
+    const int leader = leaderOf(vehicleIndex);
+    if (leader < 0) return kNoGap;
+    return vehicles[leader]->getPositionOnEdge() - vehicles[vehicleIndex]->getPositionOnEdge();
+}
+
+const std::vector<int>* EdgeOccupancy::lane(Vertex from, Vertex to) const {
+    auto it = m_lanes.find(laneKey(from, to));
+    return it != m_lanes.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,98 @@
+#include "geographic_forwarding.h"
+
+#include <cmath>
+#include <algorithm>
+
+GeographicForwarding::GeographicForwarding(int maxHops)
+    : m_maxHops(maxHops) {}
+
+int GeographicForwarding::nextHop(const InterferenceGraph::Generation& gen, int current, int destination) {
+    // Strictement plus proche que le porteur, sinon minimum local
+    double best = squaredDistance(gen, current, destination);
+    int next = -1;
+    for (const int* it = gen.neighborsBegin(current); it != gen.neighborsEnd(current); ++it) {
+        if (*it == destination) return destination;
+        const double d = squaredDistance(gen, *it, destination);
+        if (d < best) {
+            best = d;
+            next = *it;
+        }
+    }
+    return next;
+}
+
+GeographicForwarding::Result GeographicForwarding::forward(const InterferenceGraph::Generation& gen,
+                                                           int sourceId, int destinationId,
+                                                           std::vector<int>* path) {
+    Result result;
+    if (path) path->clear();
+
+    const int source = gen.indexOf(sourceId);
+    const int destination = gen.indexOf(destinationId);
+    if (source < 0 || destination < 0) return result;
+
+    int current = source;
+    if (path) path->push_back(sourceId);
+
+    // La distance à la destination décroît strictement : pas de boucle possible
+    while (current != destination) {
+        if (result.hops >= m_maxHops) {
+            result.outcome = Outcome::HopLimit;
+            result.stuckAt = gen.idAt(current);
+            return result;
+        }
+
+        const int next = nextHop(gen, current, destination);
+        if (next < 0) {
+            result.outcome = Outcome::LocalMinimum;
+            result.stuckAt = gen.idAt(current);
+            return result;
+        }
+
+        current = next;
+        ++result.hops;
+        if (path) path->push_back(gen.idAt(current));
+    }
+
+    result.outcome = Outcome::Delivered;
+    return result;
+}
+
+GeographicForwarding::Stats GeographicForwarding::evaluate(const InterferenceGraph::Generation& gen,
+                                                           const std::vector<std::pair<int, int>>& pairs,
+                                                           bool computeStretch) {
+    Stats stats;
+
+    for (const auto& [sourceId, destinationId] : pairs) {
+        const int source = gen.indexOf(sourceId);
+        const int destination = gen.indexOf(destinationId);
+        if (source < 0 || destination < 0 || source == destination) continue;
+
+        ++stats.attempts;
+        const bool connected = gen.componentOf(source) == gen.componentOf(destination);
+        if (connected) ++stats.connected;
+
+        Result result = forward(gen, sourceId, destinationId);
+        switch (result.outcome) {
+        case Outcome::Delivered:
+            ++stats.delivered;
+            if (computeStretch && gen.getShortestHopPath(sourceId, destinationId, m_optimal)) {
+                const int optimalHops = int(m_optimal.size()) - 1;
+                stats.sumStretch += double(result.hops) / optimalHops;
+                ++stats.stretchSamples;
+                stats.maxStretchHops = std::max(stats.maxStretchHops, result.hops - optimalHops);
+            }
+            break;
+        case Outcome::LocalMinimum:
+            if (connected) ++stats.localMinima;
+            break;
+        case Outcome::HopLimit:
+            ++stats.hopLimited;
+            break;
+        case Outcome::UnknownVehicle:
+            break;
+        }
+    }
+
+    return stats;
+}
@@ -66,6 +66,22 @@ double GraphBuilder::distance(double lat1, double lon1, double lat2, double lon2
     return R * c;
 }
 
+// Empreinte du graphe (FNV-1a sur sa taille et les identifiants OSM des sommets)
+uint64_t GraphBuilder::fingerprint(const RoadGraph& graph) {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](uint64_t x) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (x >> (8 * i)) & 0xff;
+            h *= 1099511628211ULL;
+        }
+    };
+    mix(boost::num_vertices(graph));
+    mix(boost::num_edges(graph));
+    auto [vStart, vEnd] = boost::vertices(graph);
+    for (auto it = vStart; it != vEnd; ++it) mix(uint64_t(graph[*it].id));
+    return h;
+}
+
 // Affiche un résumé du graphe construit
 void GraphBuilder::printSummary() const {
     cout << "Résumé du graphe :" << endl;
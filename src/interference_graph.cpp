@@ -1,183 +1,790 @@
 #include "interference_graph.h"
 #include "vehicule.h"
+#include "graph_builder.h"
+#include "kinetic_links.h"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 
-InterferenceGraph::InterferenceGraph() {}
+namespace {
 
-InterferenceGraph::~InterferenceGraph() {
-    clear();
+constexpr double kEarthRadius = 6371000.0;   // mètres, comme GraphBuilder::distance
+constexpr double kDegToRad = M_PI / 180.0;
+
+// Espace de travail BFS réutilisé d'une requête à l'autre (un par thread) :
+// un sommet est visité si son tampon vaut l'estampille de la requête en cours,
+// ce qui évite de réinitialiser le tableau à chaque parcours.
+struct BfsWorkspace {
+    std::vector<uint32_t> stamp;
+    uint32_t current = 0;
+    std::vector<int> queue;
+
+    void reset(int n) {
+        if (int(stamp.size()) < n) stamp.resize(n, 0);
+        if (++current == 0) {
+            // Débordement de l'estampille : remise à zéro complète (rarissime)
+            std::fill(stamp.begin(), stamp.end(), 0);
+            current = 1;
+        }
+        queue.clear();
+    }
+
+    bool visit(int i) {
+        if (stamp[i] == current) return false;
+        stamp[i] = current;
+        return true;
+    }
+};
+
+BfsWorkspace& bfsWorkspace() {
+    thread_local BfsWorkspace ws;
+    return ws;
+}
+
+// BFS borné depuis source ; appelle emit(index, sauts) pour chaque sommet atteint (source exclue)
+template <typename Emit>
+void boundedBfs(const InterferenceGraph::Generation& gen, int source, int maxHops, Emit emit) {
+    BfsWorkspace& ws = bfsWorkspace();
+    ws.reset(gen.vehicleCount());
+    ws.visit(source);
+    ws.queue.push_back(source);
+
+    // La file est parcourue niveau par niveau : [head, levelEnd) = sommets à hop sauts
+    size_t head = 0;
+    for (int hop = 1; hop <= maxHops && head < ws.queue.size(); ++hop) {
+        const size_t levelEnd = ws.queue.size();
+        for (; head < levelEnd; ++head) {
+            const int current = ws.queue[head];
+            for (const int* it = gen.neighborsBegin(current); it != gen.neighborsEnd(current); ++it) {
+                if (ws.visit(*it)) {
+                    ws.queue.push_back(*it);
+                    emit(*it, hop);
+                }
+            }
+        }
+    }
+}
+
+// Espace de travail du BFS bidirectionnel : un côté par extrémité, même principe d'estampille
+struct PathWorkspace {
+    struct Side {
+        std::vector<uint32_t> stamp;
+        std::vector<int> parent;
+        std::vector<int> depth;
+        std::vector<int> queue;
+    };
+
+    Side side[2];
+    uint32_t current = 0;
+
+    void reset(int n) {
+        for (Side& sd : side) {
+            if (int(sd.stamp.size()) < n) {
+                sd.stamp.resize(n, 0);
+                sd.parent.resize(n);
+                sd.depth.resize(n);
+            }
+            sd.queue.clear();
+        }
+        if (++current == 0) {
+            for (Side& sd : side) std::fill(sd.stamp.begin(), sd.stamp.end(), 0);
+            current = 1;
+        }
+    }
+
+    bool visited(int s, int i) const { return side[s].stamp[i] == current; }
+
+    void visit(int s, int i, int parent, int depth) {
+        side[s].stamp[i] = current;
+        side[s].parent[i] = parent;
+        side[s].depth[i] = depth;
+        side[s].queue.push_back(i);
+    }
+};
+
+PathWorkspace& pathWorkspace() {
+    thread_local PathWorkspace ws;
+    return ws;
+}
+
+// Plus court chemin en indices denses (source -> destination), false si aucun
+bool bidirectionalBfs(const InterferenceGraph::Generation& gen, int source, int destination,
+                      std::vector<int>& path) {
+    path.clear();
+    if (source == destination) {
+        path.push_back(source);
+        return true;
+    }
+    if (gen.componentOf(source) != gen.componentOf(destination)) return false;
+
+    PathWorkspace& ws = pathWorkspace();
+    ws.reset(gen.vehicleCount());
+    ws.visit(0, source, -1, 0);
+    ws.visit(1, destination, -1, 0);
+
+    size_t head[2] = {0, 0};
+    int meetFrom = -1;      // dernier sommet du côté étendu
+    int meetTo = -1;        // premier sommet déjà vu par l'autre côté
+    int meetSide = 0;
+
+    while (meetFrom < 0) {
+        // Étendre le côté dont la frontière (niveau courant) est la plus petite
+        size_t frontier0 = ws.side[0].queue.size() - head[0];
+        size_t frontier1 = ws.side[1].queue.size() - head[1];
+        if (frontier0 == 0 || frontier1 == 0) return false;
+        const int s = frontier0 <= frontier1 ? 0 : 1;
+        const int other = 1 - s;
+
+        // Un niveau complet : parmi les rencontres du niveau, garder la plus proche de l'autre extrémité
+        PathWorkspace::Side& sd = ws.side[s];
+        const size_t levelEnd = sd.queue.size();
+        int best = -1;
+        for (; head[s] < levelEnd; ++head[s]) {
+            const int current = sd.queue[head[s]];
+            for (const int* it = gen.neighborsBegin(current); it != gen.neighborsEnd(current); ++it) {
+                const int next = *it;
+                if (ws.visited(other, next)) {
+                    const int d = ws.side[other].depth[next];
+                    if (best < 0 || d < best) {
+                        best = d;
+                        meetFrom = current;
+                        meetTo = next;
+                        meetSide = s;
+                    }
+                } else if (!ws.visited(s, next)) {
+                    ws.visit(s, next, current, sd.depth[current] + 1);
+                }
+            }
+        }
+    }
+
+    // Côté étendu : remonter jusqu'à sa racine ; autre côté : descendre jusqu'à la sienne
+    for (int v = meetFrom; v >= 0; v = ws.side[meetSide].parent[v]) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    for (int v = meetTo; v >= 0; v = ws.side[1 - meetSide].parent[v]) path.push_back(v);
+
+    // Le chemin part de la racine du côté étendu : le remettre dans le sens source -> destination
+    if (meetSide == 1) std::reverse(path.begin(), path.end());
+    return true;
+}
+
+} // namespace
+
+std::atomic<uint64_t> InterferenceGraph::s_nextEpoch{1};
+
+InterferenceGraph::InterferenceGraph()
+    : m_current(std::make_shared<Generation>()) {}
+
+InterferenceGraph::~InterferenceGraph() {}
+
+InterferenceGraph::GenerationPtr InterferenceGraph::snapshot() const {
+    return std::atomic_load(&m_current);
+}
+
+void InterferenceGraph::publish(std::shared_ptr<Generation> gen) {
+    gen->m_epoch = s_nextEpoch.fetch_add(1, std::memory_order_relaxed);
+    if (m_trackChanges) {
+        gen->m_tracked = true;
+        computeChanges(*m_current, *gen);
+    }
+    // Les lecteurs qui tiennent l'ancienne génération la gardent jusqu'à ce qu'ils la relâchent
+    std::atomic_store(&m_current, GenerationPtr(std::move(gen)));
 }
 
 void InterferenceGraph::clear() {
-    m_adjacencyList.clear();
-    m_transitiveClosure.clear();
+    publish(std::make_shared<Generation>());
+}
+
+void InterferenceGraph::buildGraph(const std::vector<VehicleState>& states) {
+    publish(buildGeneration(states));
 }
 
 void InterferenceGraph::buildGraph(const std::vector<Vehicule*>& vehicles) {
-    // Étape 1: Effacer le graphe précédent
-    clear();
+    // Étape 1: Relever positions et portées (une seule fois par véhicule)
+    std::vector<VehicleState> states;
+    std::vector<Vehicule*> byIndex;
+    states.reserve(vehicles.size());
+    byIndex.reserve(vehicles.size());
 
-    if (vehicles.empty()) {
-        return;
+    for (auto* v : vehicles) {
+        if (!v) continue;
+        auto [lat, lon] = v->getPosition();
+        states.push_back({v->getId(), lat, lon, v->getTransmissionRange()});
+        byIndex.push_back(v);
     }
 
-    // Étape 2: Initialiser les ensembles vides pour chaque véhicule
-    for (auto* v : vehicles) {
-        if (v) {
-            m_adjacencyList[v->getId()] = std::unordered_set<int>();
+    // Étape 2: Connexions directes et fermeture transitive
+    std::shared_ptr<Generation> gen = buildGeneration(states);
+
+    // Étape 3: Mettre à jour les voisins de chaque véhicule
+    // On considère tous les véhicules accessibles, pas seulement les directs
+    for (size_t i = 0; i < byIndex.size(); ++i) {
+        Vehicule* v = byIndex[i];
+        v->clearNeighbors();
+
+        const int comp = gen->m_component[i];
+        for (const int* it = gen->componentBegin(comp); it != gen->componentEnd(comp); ++it) {
+            if (*it != int(i)) v->addNeighbor(byIndex[*it]);
         }
     }
 
-    // Étape 3: Construire les connexions directes basées sur la portée de transmission
-    // Pour chaque paire de véhicules, vérifier s'ils sont dans la portée l'un de l'autre
-    for (size_t i = 0; i < vehicles.size(); ++i) {
-        Vehicule* v1 = vehicles[i];
-        if (!v1) continue;
+    publish(std::move(gen));
+}
 
-        for (size_t j = i + 1; j < vehicles.size(); ++j) {
-            Vehicule* v2 = vehicles[j];
-            if (!v2) continue;
+void InterferenceGraph::setPropagationModel(PropagationModel model, const RadioParams& params) {
+    m_model = model;
+    m_radio = params;
+    m_logDistance = propagation::LogDistance(params);
+    m_shadowing.reset();
+    if (model == PropagationModel::Shadowing) {
+        m_shadowing = std::make_unique<propagation::Shadowing>(params);
+    }
+    if (m_kinetic) m_kinetic->clear();
+}
 
-            // Calculer la distance entre les deux véhicules
-            double distance = v1->calculateDist(*v2);
+void InterferenceGraph::setKineticLinksEnabled(bool enabled, double horizon) {
+    m_kinetic.reset();
+    if (enabled) m_kinetic = std::make_unique<KineticLinks>(horizon);
+}
 
-            // Vérifier si chaque véhicule est dans la portée de l'autre
-            bool v1CanReachV2 = distance <= v1->getTransmissionRange();
-            bool v2CanReachV1 = distance <= v2->getTransmissionRange();
+template <typename Policy>
+void InterferenceGraph::buildLinks(const std::vector<VehicleState>& states, const Policy& policy,
+                                   std::vector<std::pair<int, int>>& links,
+                                   std::vector<std::pair<int, int>>* arcs) {
+    // Pour chaque paire de véhicules, vérifier s'ils peuvent se joindre
+    const int n = int(states.size());
+    for (int i = 0; i < n; ++i) {
+        const VehicleState& v1 = states[i];
+        for (int j = i + 1; j < n; ++j) {
+            const VehicleState& v2 = states[j];
 
-            // Les deux doivent pouvoir se joindre (communication bidirectionnelle)
-            if (v1CanReachV2 && v2CanReachV1) {
-                // Ajouter la connexion bidirectionnelle
-                m_adjacencyList[v1->getId()].insert(v2->getId());
-                m_adjacencyList[v2->getId()].insert(v1->getId());
+            // Calculer la distance entre les deux véhicules
+            double distance = GraphBuilder::distance(v1.lat, v1.lon, v2.lat, v2.lon);
+
+            if (arcs) {
+                // Mode orienté : chaque sens séparément, lien si les deux
+                const bool forward = policy.reaches(v1, v2, distance);
+                const bool backward = policy.reaches(v2, v1, distance);
+                if (forward) arcs->push_back({i, j});
+                if (backward) arcs->push_back({j, i});
+                if (forward && backward) links.push_back({i, j});
+            } else if (policy.linked(v1, v2, distance)) {
+                // Les deux doivent pouvoir se joindre (communication bidirectionnelle)
+                links.push_back({i, j});
             }
         }
     }
+}
+
+template <typename Policy>
+void InterferenceGraph::findLinks(const std::vector<VehicleState>& states, const Policy& policy,
+                                  std::vector<std::pair<int, int>>& links,
+                                  std::vector<std::pair<int, int>>* arcs) {
+    if (m_kinetic && !arcs) {
+        m_kinetic->update(states, policy, links);
+    } else {
+        buildLinks(states, policy, links, arcs);
+    }
+}
+
+std::shared_ptr<InterferenceGraph::Generation>
+InterferenceGraph::buildGeneration(const std::vector<VehicleState>& states) {
+    auto gen = std::make_shared<Generation>();
+    const int n = int(states.size());
+
+    // Initialiser la numérotation dense des véhicules
+    gen->m_ids.reserve(n);
+    gen->m_indexOf.reserve(n);
+    gen->m_lat.reserve(n);
+    gen->m_lon.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        gen->m_ids.push_back(states[i].id);
+        gen->m_indexOf[states[i].id] = i;
+        gen->m_lat.push_back(states[i].lat);
+        gen->m_lon.push_back(states[i].lon);
+    }
+
+    // Projection équirectangulaire autour de la latitude moyenne
+    double meanLat = 0.0;
+    for (int i = 0; i < n; ++i) meanLat += states[i].lat;
+    if (n > 0) meanLat /= n;
+    const double kx = kEarthRadius * kDegToRad * std::cos(meanLat * kDegToRad);
+    const double ky = kEarthRadius * kDegToRad;
+    gen->m_x.resize(n);
+    gen->m_y.resize(n);
+    for (int i = 0; i < n; ++i) {
+        gen->m_x[i] = states[i].lon * kx;
+        gen->m_y[i] = states[i].lat * ky;
+    }
+
+    // Construire les connexions directes selon le modèle de propagation
+    std::vector<std::pair<int, int>> links;
+    std::vector<std::pair<int, int>> arcs;
+    std::vector<std::pair<int, int>>* directed = m_directedLinks ? &arcs : nullptr;
+    switch (m_model) {
+    case PropagationModel::UnitDisk:
+        findLinks(states, propagation::UnitDisk(), links, directed);
+        break;
+    case PropagationModel::LogDistance:
+        findLinks(states, m_logDistance, links, directed);
+        break;
+    case PropagationModel::Shadowing:
+        findLinks(states, *m_shadowing, links, directed);
+        break;
+    }
+
+    // Format CSR : comptage des degrés, puis remplissage
+    std::vector<int>& offsets = gen->m_offsets;
+    offsets.assign(n + 1, 0);
+    for (const auto& [a, b] : links) {
+        ++offsets[a + 1];
+        ++offsets[b + 1];
+    }
+    for (int i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+
+    gen->m_neighbors.resize(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& [a, b] : links) {
+        gen->m_neighbors[fill[a]++] = b;
+        gen->m_neighbors[fill[b]++] = a;
+    }
+    for (int i = 0; i < n; ++i) {
+        std::sort(gen->m_neighbors.begin() + offsets[i], gen->m_neighbors.begin() + offsets[i + 1]);
+    }
+
+    // Suivi des changements : liens en ids véhicules, triés
+    if (m_trackChanges) {
+        gen->m_linkKeys.reserve(links.size());
+        for (const auto& [a, b] : links) {
+            const uint32_t lo = uint32_t(std::min(states[a].id, states[b].id));
+            const uint32_t hi = uint32_t(std::max(states[a].id, states[b].id));
+            gen->m_linkKeys.push_back(uint64_t(lo) << 32 | hi);
+        }
+        std::sort(gen->m_linkKeys.begin(), gen->m_linkKeys.end());
+    }
 
-    // Étape 4: Calculer la fermeture transitive
+    // Calculer la fermeture transitive
     // Si A peut communiquer avec B et B avec C, alors A peut communiquer avec C
-    computeTransitiveClosure();
+    computeTransitiveClosure(*gen);
 
-    // Étape 5: Mettre à jour les voisins de chaque véhicule
-    // Maintenant on considère tous les véhicules accessibles, pas seulement les directs
-    for (auto* v : vehicles) {
-        if (!v) continue;
+    // Mode orienté : arcs au format CSR, puis composantes fortement connexes
+    if (directed) {
+        gen->m_directed = true;
+        std::vector<int>& outOffsets = gen->m_outOffsets;
+        outOffsets.assign(n + 1, 0);
+        for (const auto& arc : arcs) ++outOffsets[arc.first + 1];
+        for (int i = 0; i < n; ++i) outOffsets[i + 1] += outOffsets[i];
 
-        v->clearNeighbors();
-        
-        // Obtenir tous les véhicules accessibles (directement ou indirectement)
-        const auto& reachable = m_transitiveClosure[v->getId()];
-        
-        for (auto* other : vehicles) {
-            if (!other || other == v) continue;
-            
-            // Si le véhicule est accessible, l'ajouter comme voisin
-            if (reachable.find(other->getId()) != reachable.end()) {
-                v->addNeighbor(other);
+        gen->m_outArcs.resize(arcs.size());
+        std::vector<int> next(outOffsets.begin(), outOffsets.end() - 1);
+        for (const auto& [from, to] : arcs) gen->m_outArcs[next[from]++] = to;
+        for (int i = 0; i < n; ++i) {
+            std::sort(gen->m_outArcs.begin() + outOffsets[i], gen->m_outArcs.begin() + outOffsets[i + 1]);
+        }
+
+        computeStronglyConnected(*gen);
+    }
+    return gen;
+}
+
+void InterferenceGraph::computeTransitiveClosure(Generation& gen) {
+    // Le graphe est non orienté : la fermeture transitive est exactement
+    // la partition en composantes connexes, calculée par parcours en largeur (BFS)
+    const int n = gen.vehicleCount();
+    gen.m_component.assign(n, -1);
+    gen.m_componentOffsets.assign(1, 0);
+    gen.m_componentMembers.clear();
+    gen.m_componentMembers.reserve(n);
+
+    for (int start = 0; start < n; ++start) {
+        if (gen.m_component[start] != -1) continue;
+
+        const int comp = int(gen.m_componentOffsets.size()) - 1;
+        size_t head = gen.m_componentMembers.size();
+        gen.m_component[start] = comp;
+        gen.m_componentMembers.push_back(start);
+
+        // Les membres de la composante servent eux-mêmes de file d'attente
+        while (head < gen.m_componentMembers.size()) {
+            const int current = gen.m_componentMembers[head++];
+            for (const int* it = gen.neighborsBegin(current); it != gen.neighborsEnd(current); ++it) {
+                if (gen.m_component[*it] == -1) {
+                    gen.m_component[*it] = comp;
+                    gen.m_componentMembers.push_back(*it);
+                }
             }
         }
+        gen.m_componentOffsets.push_back(int(gen.m_componentMembers.size()));
     }
 }
 
-void InterferenceGraph::computeTransitiveClosure() {
-    // Pour chaque véhicule, calculer tous les véhicules accessibles
-    // en utilisant un parcours en largeur (BFS)
-    
-    m_transitiveClosure.clear();
-    
-    for (const auto& [vehicleId, neighbors] : m_adjacencyList) {
-        m_transitiveClosure[vehicleId] = bfsReachable(vehicleId);
+void InterferenceGraph::computeChanges(const Generation& prev, Generation& next) {
+    LinkChanges& changes = next.m_changes;
+    changes = LinkChanges();
+
+    auto unpack = [](uint64_t key) { return std::make_pair(int(uint32_t(key >> 32)), int(uint32_t(key))); };
+
+    // Première génération suivie : tous les liens sont nouveaux
+    if (!prev.m_tracked) {
+        changes.added.reserve(next.m_linkKeys.size());
+        for (uint64_t key : next.m_linkKeys) changes.added.push_back(unpack(key));
+        return;
+    }
+    changes.fromEpoch = prev.m_epoch;
+
+    // Fusion des deux tableaux triés
+    const std::vector<uint64_t>& before = prev.m_linkKeys;
+    const std::vector<uint64_t>& after = next.m_linkKeys;
+    size_t i = 0, j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i] < after[j])) {
+            changes.removed.push_back(unpack(before[i++]));
+        } else if (i == before.size() || after[j] < before[i]) {
+            changes.added.push_back(unpack(after[j++]));
+        } else {
+            ++i;
+            ++j;
+        }
     }
+
+    // Toute fusion passe par un lien ajouté entre deux anciennes composantes,
+    // toute scission par un lien retiré : seules leurs extrémités sont examinées.
+    // Triplets (composante concernée, composante de l'autre génération, véhicule)
+    struct Touch {
+        int component, other, vehicleId;
+        bool operator<(const Touch& t) const {
+            return component != t.component ? component < t.component : other < t.other;
+        }
+    };
+    auto collect = [](const std::vector<std::pair<int, int>>& links, const Generation& here,
+                      const Generation& there, std::vector<LinkChanges::ComponentEvent>& events) {
+        std::vector<Touch> touches;
+        for (const auto& [a, b] : links) {
+            const int comp = here.m_component[here.indexOf(a)];
+            for (int id : {a, b}) {
+                const int k = there.indexOf(id);
+                if (k >= 0) touches.push_back({comp, there.m_component[k], id});
+            }
+        }
+        std::sort(touches.begin(), touches.end());
+
+        for (size_t begin = 0; begin < touches.size();) {
+            LinkChanges::ComponentEvent event{touches[begin].component, {}};
+            size_t end = begin;
+            for (; end < touches.size() && touches[end].component == event.component; ++end) {
+                if (end == begin || touches[end].other != touches[end - 1].other) {
+                    event.parts.push_back(touches[end].vehicleId);
+                }
+            }
+            if (event.parts.size() > 1) events.push_back(std::move(event));
+            begin = end;
+        }
+    };
+    collect(changes.added, next, prev, changes.merges);
+    collect(changes.removed, prev, next, changes.splits);
 }
 
-std::unordered_set<int> InterferenceGraph::bfsReachable(int startId) const {
-    std::unordered_set<int> visited;
-    std::queue<int> toVisit;
-    
-    toVisit.push(startId);
-    visited.insert(startId);
-    
-    while (!toVisit.empty()) {
-        int currentId = toVisit.front();
-        toVisit.pop();
-        
-        // Vérifier si ce véhicule existe dans le graphe
-        auto it = m_adjacencyList.find(currentId);
-        if (it == m_adjacencyList.end()) {
-            continue;
+void InterferenceGraph::computeStronglyConnected(Generation& gen) {
+    // Tarjan avec une pile d'appels explicite : (sommet, prochain arc à explorer)
+    const int n = gen.vehicleCount();
+    std::vector<int> order(n, -1);      // ordre de découverte
+    std::vector<int> low(n, 0);
+    std::vector<char> onStack(n, 0);
+    std::vector<int> stack;
+    std::vector<std::pair<int, int>> calls;
+    int counter = 0;
+
+    gen.m_scc.assign(n, -1);
+    gen.m_sccCount = 0;
+
+    for (int start = 0; start < n; ++start) {
+        if (order[start] != -1) continue;
+
+        order[start] = low[start] = counter++;
+        stack.push_back(start);
+        onStack[start] = 1;
+        calls.push_back({start, gen.m_outOffsets[start]});
+
+        while (!calls.empty()) {
+            const int v = calls.back().first;
+            const int pos = calls.back().second;
+
+            if (pos < gen.m_outOffsets[v + 1]) {
+                calls.back().second++;
+                const int w = gen.m_outArcs[pos];
+                if (order[w] == -1) {
+                    order[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    onStack[w] = 1;
+                    calls.push_back({w, gen.m_outOffsets[w]});
+                } else if (onStack[w]) {
+                    low[v] = std::min(low[v], order[w]);
+                }
+                continue;
+            }
+
+            // Tous les arcs de v explorés : remonter, puis fermer la composante si v en est la racine
+            calls.pop_back();
+            if (!calls.empty()) {
+                const int parent = calls.back().first;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+            if (low[v] == order[v]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = 0;
+                    gen.m_scc[w] = gen.m_sccCount;
+                } while (w != v);
+                ++gen.m_sccCount;
+            }
+        }
+    }
+}
+
+int InterferenceGraph::Generation::indexOf(int vehicleId) const {
+    auto it = m_indexOf.find(vehicleId);
+    return it != m_indexOf.end() ? it->second : -1;
+}
+
+bool InterferenceGraph::Generation::canCommunicate(int id1, int id2) const {
+    // Même composante connexe et véhicules distincts
+    const int i = indexOf(id1);
+    const int j = indexOf(id2);
+    if (i < 0 || j < 0 || i == j) return false;
+    return m_component[i] == m_component[j];
+}
+
+bool InterferenceGraph::Generation::canReach(int fromId, int toId) const {
+    if (!m_directed) return canCommunicate(fromId, toId);
+
+    const int i = indexOf(fromId);
+    const int j = indexOf(toId);
+    if (i < 0 || j < 0 || i == j) return false;
+    if (m_scc[i] == m_scc[j]) return true;
+
+    // BFS sur les arcs sortants, arrêté dès que la cible est atteinte
+    BfsWorkspace& ws = bfsWorkspace();
+    ws.reset(vehicleCount());
+    ws.visit(i);
+    ws.queue.push_back(i);
+    for (size_t head = 0; head < ws.queue.size(); ++head) {
+        const int current = ws.queue[head];
+        for (const int* it = outBegin(current); it != outEnd(current); ++it) {
+            if (*it == j) return true;
+            if (ws.visit(*it)) ws.queue.push_back(*it);
         }
-        
-        // Explorer tous les voisins directs
-        for (int neighborId : it->second) {
-            // Si on n'a pas encore visité ce voisin
-            if (visited.find(neighborId) == visited.end()) {
-                visited.insert(neighborId);
-                toVisit.push(neighborId);
+    }
+    return false;
+}
+
+bool InterferenceGraph::Generation::stronglyConnected(int id1, int id2) const {
+    if (!m_directed) return canCommunicate(id1, id2);
+
+    const int i = indexOf(id1);
+    const int j = indexOf(id2);
+    if (i < 0 || j < 0 || i == j) return false;
+    return m_scc[i] == m_scc[j];
+}
+
+std::unordered_set<int> InterferenceGraph::Generation::getDirectedReachableVehicles(int vehicleId) const {
+    if (!m_directed) return getReachableVehicles(vehicleId);
+
+    std::unordered_set<int> reachable;
+    const int i = indexOf(vehicleId);
+    if (i < 0) return reachable;
+
+    BfsWorkspace& ws = bfsWorkspace();
+    ws.reset(vehicleCount());
+    ws.visit(i);
+    ws.queue.push_back(i);
+    for (size_t head = 0; head < ws.queue.size(); ++head) {
+        const int current = ws.queue[head];
+        for (const int* it = outBegin(current); it != outEnd(current); ++it) {
+            if (ws.visit(*it)) {
+                ws.queue.push_back(*it);
+                reachable.insert(m_ids[*it]);
             }
         }
     }
-    
-    // Retirer le nœud de départ de l'ensemble des accessibles
-    visited.erase(startId);
-    
-    return visited;
+    return reachable;
 }
 
-bool InterferenceGraph::canCommunicate(int id1, int id2) const {
-    // Vérifier si id2 est dans l'ensemble des véhicules accessibles depuis id1
-    auto it = m_transitiveClosure.find(id1);
-    if (it == m_transitiveClosure.end()) {
-        return false;
+std::unordered_set<int> InterferenceGraph::Generation::getReachableVehicles(int vehicleId) const {
+    std::unordered_set<int> reachable;
+    const int i = indexOf(vehicleId);
+    if (i < 0) return reachable;
+
+    const int comp = m_component[i];
+    reachable.reserve(componentSize(comp));
+    for (const int* it = componentBegin(comp); it != componentEnd(comp); ++it) {
+        if (*it != i) reachable.insert(m_ids[*it]);
     }
-    
-    return it->second.find(id2) != it->second.end();
+    return reachable;
 }
 
-std::unordered_set<int> InterferenceGraph::getReachableVehicles(int vehicleId) const {
-    auto it = m_transitiveClosure.find(vehicleId);
-    if (it != m_transitiveClosure.end()) {
-        return it->second;
+std::unordered_set<int> InterferenceGraph::Generation::getDirectNeighbors(int vehicleId) const {
+    std::unordered_set<int> neighbors;
+    const int i = indexOf(vehicleId);
+    if (i < 0) return neighbors;
+
+    neighbors.reserve(degree(i));
+    for (const int* it = neighborsBegin(i); it != neighborsEnd(i); ++it) {
+        neighbors.insert(m_ids[*it]);
     }
-    return std::unordered_set<int>();
+    return neighbors;
 }
 
-std::unordered_set<int> InterferenceGraph::getDirectNeighbors(int vehicleId) const {
-    auto it = m_adjacencyList.find(vehicleId);
-    if (it != m_adjacencyList.end()) {
-        return it->second;
+int InterferenceGraph::Generation::getDirectNeighborCount(int vehicleId) const {
+    const int i = indexOf(vehicleId);
+    return i < 0 ? 0 : degree(i);
+}
+
+int InterferenceGraph::Generation::getVehiclesWithinHops(int vehicleId, int maxHops, std::vector<int>& out,
+                                                        std::vector<int>* hops) const {
+    out.clear();
+    if (hops) hops->clear();
+
+    const int i = indexOf(vehicleId);
+    if (i < 0 || maxHops < 1) return 0;
+
+    boundedBfs(*this, i, maxHops, [&](int index, int hop) {
+        out.push_back(m_ids[index]);
+        if (hops) hops->push_back(hop);
+    });
+    return int(out.size());
+}
+
+void InterferenceGraph::Generation::getVehiclesWithinHops(const std::vector<int>& sources, int maxHops,
+                                                         std::vector<int>& offsets, std::vector<int>& ids) const {
+    offsets.assign(1, 0);
+    offsets.reserve(sources.size() + 1);
+    ids.clear();
+
+    for (int vehicleId : sources) {
+        const int i = indexOf(vehicleId);
+        if (i >= 0 && maxHops >= 1) {
+            boundedBfs(*this, i, maxHops, [&](int index, int) { ids.push_back(m_ids[index]); });
+        }
+        offsets.push_back(int(ids.size()));
+    }
+}
+
+bool InterferenceGraph::Generation::getShortestHopPath(int sourceId, int destinationId,
+                                                     std::vector<int>& path) const {
+    path.clear();
+    const int i = indexOf(sourceId);
+    const int j = indexOf(destinationId);
+    if (i < 0 || j < 0 || !bidirectionalBfs(*this, i, j, path)) return false;
+
+    for (int& v : path) v = m_ids[v];
+    return true;
+}
+
+void InterferenceGraph::Generation::getShortestHopPaths(const std::vector<std::pair<int, int>>& pairs,
+                                                      std::vector<int>& offsets, std::vector<int>& ids) const {
+    offsets.assign(1, 0);
+    offsets.reserve(pairs.size() + 1);
+    ids.clear();
+
+    std::vector<int> path;
+    for (const auto& [sourceId, destinationId] : pairs) {
+        const int i = indexOf(sourceId);
+        const int j = indexOf(destinationId);
+        if (i >= 0 && j >= 0 && bidirectionalBfs(*this, i, j, path)) {
+            for (int v : path) ids.push_back(m_ids[v]);
+        }
+        offsets.push_back(int(ids.size()));
+    }
+}
+
+void InterferenceGraph::Generation::exportLinks(SimulationSnapshot& snap) const {
+    const int n = int(snap.vehicles.size());
+    snap.links.clear();
+    snap.component.assign(n, 0);
+
+    // index de la photo <-> index dense de la génération
+    std::vector<int> toSnap(m_ids.size(), -1);
+    std::vector<int> toGen(n, -1);
+    for (int i = 0; i < n; ++i) {
+        toGen[i] = indexOf(snap.vehicles[i].id);
+        if (toGen[i] >= 0) toSnap[toGen[i]] = i;
+    }
+
+    // Liens une seule fois (i < j) ; représentant = plus petit index de la composante
+    std::vector<int> representative(componentCount(), -1);
+    for (int i = 0; i < n; ++i) {
+        const int gi = toGen[i];
+        if (gi < 0) {
+            snap.component[i] = i;
+            continue;
+        }
+        int& rep = representative[componentOf(gi)];
+        if (rep < 0) rep = i;
+        snap.component[i] = rep;
+
+        for (const int* nb = neighborsBegin(gi); nb != neighborsEnd(gi); ++nb) {
+            const int j = toSnap[*nb];
+            if (j > i) snap.links.push_back({i, j});
+        }
     }
-    return std::unordered_set<int>();
+}
+
+bool InterferenceGraph::canCommunicate(int id1, int id2) const {
+    return snapshot()->canCommunicate(id1, id2);
+}
+
+bool InterferenceGraph::canReach(int fromId, int toId) const {
+    return snapshot()->canReach(fromId, toId);
+}
+
+std::unordered_set<int> InterferenceGraph::getReachableVehicles(int vehicleId) const {
+    return snapshot()->getReachableVehicles(vehicleId);
+}
+
+std::unordered_set<int> InterferenceGraph::getDirectNeighbors(int vehicleId) const {
+    return snapshot()->getDirectNeighbors(vehicleId);
+}
+
+int InterferenceGraph::getDirectNeighborCount(int vehicleId) const {
+    return snapshot()->getDirectNeighborCount(vehicleId);
+}
+
+std::vector<int> InterferenceGraph::getVehiclesWithinHops(int vehicleId, int maxHops) const {
+    std::vector<int> ids;
+    snapshot()->getVehiclesWithinHops(vehicleId, maxHops, ids);
+    return ids;
+}
+
+std::vector<int> InterferenceGraph::getShortestHopPath(int id1, int id2) const {
+    std::vector<int> path;
+    snapshot()->getShortestHopPath(id1, id2, path);
+    return path;
 }
 
 void InterferenceGraph::printStats() const {
+    GenerationPtr gen = snapshot();
+
     std::cout << "\n=== Statistiques du Graphe d'Interférence ===" << std::endl;
-    std::cout << "Nombre de véhicules: " << m_adjacencyList.size() << std::endl;
-    
-    int totalDirectConnections = 0;
-    int totalTransitiveConnections = 0;
-    
-    for (const auto& [id, neighbors] : m_adjacencyList) {
-        totalDirectConnections += neighbors.size();
-    }
+    std::cout << "Génération: " << gen->epoch() << std::endl;
+    std::cout << "Nombre de véhicules: " << gen->vehicleCount() << std::endl;
     
-    for (const auto& [id, reachable] : m_transitiveClosure) {
-        totalTransitiveConnections += reachable.size();
+    long long totalTransitiveConnections = 0;
+    for (int c = 0; c < gen->componentCount(); ++c) {
+        long long size = gen->componentSize(c);
+        totalTransitiveConnections += size * (size - 1) / 2;
     }
     
-    // Diviser par 2 car chaque connexion directe est comptée deux fois (bidirectionnelle)
-    std::cout << "Connexions directes: " << totalDirectConnections / 2 << std::endl;
-    std::cout << "Connexions totales (avec transitivité): " << totalTransitiveConnections / 2 << std::endl;
+    std::cout << "Connexions directes: " << gen->linkCount() << std::endl;
+    std::cout << "Connexions totales (avec transitivité): " << totalTransitiveConnections << std::endl;
     
     // Afficher quelques exemples de véhicules avec leurs connexions
-    int count = 0;
-    for (const auto& [id, reachable] : m_transitiveClosure) {
-        if (count++ >= 5) break; // Afficher seulement les 5 premiers
-        
-        auto directNeighbors = getDirectNeighbors(id);
-        std::cout << "Véhicule " << id << ": " 
-                  << directNeighbors.size() << " voisins directs, "
-                  << reachable.size() << " véhicules accessibles" << std::endl;
+    for (int i = 0; i < gen->vehicleCount() && i < 5; ++i) { // Afficher seulement les 5 premiers
+        std::cout << "Véhicule " << gen->idAt(i) << ": " 
+                  << gen->degree(i) << " voisins directs, "
+                  << gen->componentSize(gen->componentOf(i)) - 1 << " véhicules accessibles" << std::endl;
     }
     std::cout << "==========================================\n" << std::endl;
 }
@@ -1,7 +1,26 @@
 #include "interference_graph_test.h"
 #include "graph_builder.h"
+#include "dissemination.h"
+#include "geographic_forwarding.h"
+#include "mac_simulator.h"
+#include "sinr_model.h"
+#include "kinetic_links.h"
+#include "route_planner.h"
+#include "contraction_hierarchy.h"
+#include "edge_occupancy.h"
+#include "simulator.h"
+#include "trace_replay.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <set>
 
 using namespace std;
 
@@ -85,6 +104,14 @@ Vehicule* InterferenceGraphTest::createTestVehicle(int id, double lat, double lo
     return v;
 }
 
+vector<Vehicule*> InterferenceGraphTest::buildChain(int count, double range) {
+    vector<Vehicule*> vehicles;
+    for (int i = 0; i < count; i++) {
+        vehicles.push_back(createTestVehicle(i, 0.0, 0.0, range));
+    }
+    return vehicles;
+}
+
 void InterferenceGraphTest::cleanupVehicles(vector<Vehicule*>& vehicles) {
     for (auto* v : vehicles) {
         delete v;
@@ -92,6 +119,95 @@ void InterferenceGraphTest::cleanupVehicles(vector<Vehicule*>& vehicles) {
     vehicles.clear();
 }
 
+void InterferenceGraphTest::buildRoadGrid(RoadGraph& graph, int width, int height, unsigned seed) const {
+    mt19937 rng(seed);
+    auto addVertex = [&](double lat, double lon) {
+        Vertex v = boost::add_vertex(graph);
+        graph[v].id = long(v);
+        graph[v].lat = lat;
+        graph[v].lon = lon;
+        return v;
+    };
+    // Longueur >= distance de Haversine : l'heuristique de A* reste admissible
+    auto addRoad = [&](Vertex a, Vertex b, const string& type) {
+        EdgeData e;
+        e.distance = GraphBuilder::distance(graph[a].lat, graph[a].lon, graph[b].lat, graph[b].lon) *
+                     (1.0 + 0.5 * (rng() % 3));
+        e.oneway = false;
+        e.type = type;
+        boost::add_edge(a, b, e, graph);
+    };
+    
+    // Grille (~110m entre voisins), un tronçon sur dix non praticable
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            addVertex(48.57 + y * 0.001, 7.75 + x * 0.0015);
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Vertex v = Vertex(y * width + x);
+            if (x + 1 < width) addRoad(v, v + 1, rng() % 10 == 0 ? "footway" : "secondary");
+            if (y + 1 < height) addRoad(v, v + width, rng() % 10 == 0 ? "cycleway" : "primary");
+        }
+    }
+    
+    // Îlot praticable, sans lien avec la grille
+    const Vertex i0 = addVertex(48.60, 7.80);
+    const Vertex i1 = addVertex(48.601, 7.80);
+    const Vertex i2 = addVertex(48.601, 7.8015);
+    addRoad(i0, i1, "secondary");
+    addRoad(i1, i2, "tertiary");
+    
+    // Sommet relié à la grille par un chemin piéton seulement
+    const Vertex p = addVertex(48.569, 7.75);
+    addRoad(p, 0, "footway");
+}
+
+double InterferenceGraphTest::referenceDistance(const RoadGraph& graph, Vertex origin, Vertex destination) {
+    const double inf = numeric_limits<double>::infinity();
+    vector<double> dist(boost::num_vertices(graph), inf);
+    using Item = pair<double, Vertex>;
+    priority_queue<Item, vector<Item>, greater<Item>> open;
+    dist[origin] = 0.0;
+    open.push({0.0, origin});
+    
+    while (!open.empty()) {
+        const auto [d, u] = open.top();
+        open.pop();
+        if (d > dist[u]) continue;
+        if (u == destination) return d;
+        
+        auto [it, end] = boost::out_edges(u, graph);
+        for (; it != end; ++it) {
+            if (!Vehicule::isValidRoad(graph[*it].type)) continue;
+            const Vertex v = boost::target(*it, graph);
+            if (d + graph[*it].distance < dist[v]) {
+                dist[v] = d + graph[*it].distance;
+                open.push({dist[v], v});
+            }
+        }
+    }
+    return inf;
+}
+
+double InterferenceGraphTest::routeLength(const RoadGraph& graph, const vector<Vertex>& path) {
+    double length = 0.0;
+    for (size_t k = 1; k < path.size(); ++k) {
+        double best = -1.0;
+        auto [it, end] = boost::out_edges(path[k - 1], graph);
+        for (; it != end; ++it) {
+            if (boost::target(*it, graph) == path[k] && Vehicule::isValidRoad(graph[*it].type) &&
+                (best < 0.0 || graph[*it].distance < best)) {
+                best = graph[*it].distance;
+            }
+        }
+        if (best < 0.0) return -1.0;
+        length += best;
+    }
+    return length;
+}
+
 bool InterferenceGraphTest::testEmptyGraph() {
     printTestHeader("Graphe vide");
     
@@ -431,6 +547,1062 @@ bool InterferenceGraphTest::testStarTopology() {
     return passed;
 }
 
+bool InterferenceGraphTest::testGenerationSnapshot() {
+    printTestHeader("Générations immuables (snapshot)");
+    
+    InterferenceGraph graph;
+    vector<Vehicule*> vehicles;
+    
+    // Deux véhicules à ~150m avec une portée de 500m : connectés
+    vehicles.push_back(createTestVehicle(0, 48.5734, 7.7521, 500.0));
+    vehicles.push_back(createTestVehicle(1, 48.5747, 7.7541, 500.0));
+    graph.buildGraph(vehicles);
+    
+    // Un lecteur garde la génération courante
+    InterferenceGraph::GenerationPtr before = graph.snapshot();
+    
+    // Nouvelle construction : plus aucune connexion
+    vehicles[0]->setTransmissionRange(1.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr after = graph.snapshot();
+    
+    cout << "  → Époque avant: " << before->epoch() << ", après: " << after->epoch() << endl;
+    
+    bool test1 = checkCondition("L'époque augmente à chaque construction", after->epoch() > before->epoch());
+    bool test2 = checkCondition("L'ancienne génération est inchangée", before->canCommunicate(0, 1));
+    bool test3 = checkCondition("La nouvelle génération voit la coupure", !after->canCommunicate(0, 1));
+    bool test4 = checkCondition("Le graphe répond avec la génération courante", !graph.canCommunicate(0, 1));
+    bool test5 = checkCondition("Voisins directs au format CSR", before->degree(before->indexOf(1)) == 1 &&
+                                                                  after->degree(after->indexOf(1)) == 0);
+    
+    // Un autre graphe ne réutilise pas les époques : (adresse, époque) reste une identité sûre
+    // pour les caches des consommateurs, même si l'adresse d'une génération libérée est reprise
+    InterferenceGraph other;
+    other.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr foreign = other.snapshot();
+    bool test6 = checkCondition("Époques uniques entre graphes",
+                                foreign->epoch() != before->epoch() && foreign->epoch() != after->epoch());
+    
+    // Positions projetées une fois par génération, cohérentes avec la distance de Haversine
+    const int a = before->indexOf(0), b = before->indexOf(1);
+    const double projected = std::hypot(before->xAt(a) - before->xAt(b), before->yAt(a) - before->yAt(b));
+    const double haversine = GraphBuilder::distance(before->latAt(a), before->lonAt(a),
+                                                    before->latAt(b), before->lonAt(b));
+    bool test7 = checkCondition("Projection équirectangulaire (écart < 0,1 %)",
+                                haversine > 0.0 && std::abs(projected - haversine) < 1e-3 * haversine);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5 && test6 && test7;
+    printTestResult("Générations immuables", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testDissemination() {
+    printTestHeader("Diffusion multi-sauts (un saut par slot)");
+    
+    InterferenceGraph graph;
+    
+    // Chaîne V0 - V1 - V2 - V3 (~200m entre voisins, portée 250m)
+    vector<Vehicule*> vehicles = buildChain(4, 250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    DisseminationEngine engine;
+    int flood = engine.inject(0);
+    int limited = engine.inject(0, 2);
+    
+    engine.step(*gen);
+    bool test1 = checkCondition("Après 1 slot : V1 atteint, pas V2",
+                                engine.hasReceived(flood, 1) && !engine.hasReceived(flood, 2));
+    
+    engine.step(*gen, 3);
+    const DisseminationEngine::MessageStats& stats = engine.stats(flood);
+    
+    cout << "  → Reçu par " << stats.delivered << " véhicule(s), " << stats.maxHops
+         << " saut(s) max, latence moyenne " << stats.meanLatencySlots() << " slot(s)" << endl;
+    
+    bool test2 = checkCondition("Toute la chaîne atteinte en 3 sauts",
+                                stats.delivered == 3 && stats.maxHops == 3 && engine.hasReceived(flood, 3));
+    bool test3 = checkCondition("Latence moyenne = 2 slots", stats.meanLatencySlots() == 2.0);
+    bool test4 = checkCondition("TTL de 2 sauts : V3 non atteint",
+                                engine.hasReceived(limited, 2) && !engine.hasReceived(limited, 3));
+    bool test5 = checkCondition("Diffusions terminées", engine.activeMessageCount() == 0);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Diffusion multi-sauts", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testHopLimitedReachability() {
+    printTestHeader("Accessibilité limitée à k sauts");
+    
+    InterferenceGraph graph;
+    
+    // Chaîne V0 - V1 - V2 - V3 (~200m entre voisins, portée 250m)
+    vector<Vehicule*> vehicles = buildChain(4, 250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    vector<int> ids, hops;
+    gen->getVehiclesWithinHops(0, 2, ids, &hops);
+    cout << "  → V0 atteint " << ids.size() << " véhicule(s) en 2 sauts" << endl;
+    
+    bool test1 = checkCondition("1 saut : seulement V1", graph.getVehiclesWithinHops(0, 1) == vector<int>{1});
+    bool test2 = checkCondition("2 sauts : V1 puis V2", ids == vector<int>{1, 2} && hops == vector<int>{1, 2});
+    bool test3 = checkCondition("Sans limite effective : toute la composante",
+                                graph.getVehiclesWithinHops(0, 10).size() == graph.getReachableVehicles(0).size());
+    
+    vector<int> offsets;
+    gen->getVehiclesWithinHops(vector<int>{0, 3, 42}, 1, offsets, ids);
+    bool test4 = checkCondition("Lot : V0 -> {V1}, V3 -> {V2}, inconnu -> {}",
+                                offsets == vector<int>{0, 1, 2, 2} && ids == vector<int>{1, 2});
+    
+    bool passed = test1 && test2 && test3 && test4;
+    printTestResult("Accessibilité k sauts", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testShortestHopPath() {
+    printTestHeader("Plus courte chaîne de relais (BFS bidirectionnel)");
+    
+    InterferenceGraph graph;
+    
+    // Chaîne V0 - V1 - V2 - V3 (~200m entre voisins, portée 250m) et V4 isolé (~5km)
+    vector<Vehicule*> vehicles = buildChain(5, 250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    vector<int> path = graph.getShortestHopPath(0, 3);
+    cout << "  → Chemin V0 -> V3 :";
+    for (int id : path) cout << " V" << id;
+    cout << endl;
+    
+    bool test1 = checkCondition("V0 -> V3 passe par V1 et V2", path == vector<int>{0, 1, 2, 3});
+    bool test2 = checkCondition("Sens inverse", graph.getShortestHopPath(3, 0) == vector<int>{3, 2, 1, 0});
+    bool test3 = checkCondition("Véhicule isolé : aucun chemin", graph.getShortestHopPath(0, 4).empty());
+    
+    vector<int> offsets, ids;
+    gen->getShortestHopPaths({{1, 2}, {2, 4}, {3, 3}}, offsets, ids);
+    bool test4 = checkCondition("Lot : voisin direct, injoignable, source = destination",
+                                offsets == vector<int>{0, 2, 2, 3} && ids == vector<int>{1, 2, 3});
+    
+    bool passed = test1 && test2 && test3 && test4;
+    printTestResult("Plus courte chaîne de relais", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testGeographicForwarding() {
+    printTestHeader("Routage géographique glouton");
+    
+    // Positions explicites, pas de 0.0018° (~200m), portée 250m :
+    // S n'a qu'un voisin A, situé derrière lui ; le détour A-B-C-E-F mène à D
+    //
+    //   F . D
+    //   E .
+    //   C .
+    //   B .
+    //   A S
+    const double step = 0.0018;
+    vector<VehicleState> states = {
+        {1, 0.0, 0.0, 250.0},           // S
+        {2, 0.0, -step, 250.0},         // A
+        {3, step, -step, 250.0},        // B
+        {4, 2 * step, -step, 250.0},    // C
+        {5, 3 * step, -step, 250.0},    // E
+        {6, 4 * step, -step, 250.0},    // F
+        {7, 4 * step, 0.0, 250.0}       // D
+    };
+    
+    InterferenceGraph graph;
+    graph.buildGraph(states);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    GeographicForwarding forwarding;
+    vector<int> path;
+    GeographicForwarding::Result stuck = forwarding.forward(*gen, 1, 7);
+    GeographicForwarding::Result direct = forwarding.forward(*gen, 2, 7, &path);
+    
+    cout << "  → A -> D en " << direct.hops << " saut(s)" << endl;
+    
+    bool test1 = checkCondition("S -> D bloqué en minimum local chez S",
+                                stuck.outcome == GeographicForwarding::Outcome::LocalMinimum && stuck.stuckAt == 1);
+    bool test2 = checkCondition("A -> D livré le long du détour",
+                                direct.outcome == GeographicForwarding::Outcome::Delivered &&
+                                path == vector<int>{2, 3, 4, 5, 6, 7});
+    
+    GeographicForwarding::Stats stats = forwarding.evaluate(*gen, {{1, 7}, {2, 7}, {7, 2}, {1, 99}});
+    cout << "  → Succès " << stats.delivered << "/" << stats.connected
+         << ", étirement moyen " << stats.meanStretch() << endl;
+    
+    bool test3 = checkCondition("Bilan : 2 livrés sur 3 connectés, 1 minimum local",
+                                stats.attempts == 3 && stats.connected == 3 &&
+                                stats.delivered == 2 && stats.localMinima == 1);
+    bool test4 = checkCondition("Étirement = 1 (chemins gloutons optimaux)", stats.meanStretch() == 1.0);
+    
+    bool passed = test1 && test2 && test3 && test4;
+    printTestResult("Routage géographique glouton", passed);
+    
+    return passed;
+}
+
+bool InterferenceGraphTest::testMacCollisions() {
+    printTestHeader("Couche MAC : contention et collisions");
+    
+    InterferenceGraph graph;
+    
+    // Chaîne V0 - V1 - V2 : V0 et V2 ne s'entendent pas (terminaux cachés)
+    vector<Vehicule*> vehicles = buildChain(3, 250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    // Une seule trame unicast V0 -> V1 : reçue intacte par V1
+    MacSimulator single;
+    single.send(0, 1, 300);
+    single.advance(*gen, 0.01);
+    const MacSimulator::Stats& s1 = single.stats();
+    
+    bool test1 = checkCondition("Trame isolée reçue par son destinataire",
+                                s1.transmissions == 1 && s1.receptions == 1 &&
+                                s1.unicastDelivered == 1 && s1.collisions == 0);
+    
+    // V0 et V2 émettent en même temps : chevauchement certain chez V1
+    // (backoff <= 15 slots de 13µs, trame de ~440µs)
+    MacSimulator hidden;
+    hidden.send(0, MacSimulator::kBroadcast, 300);
+    hidden.send(2, MacSimulator::kBroadcast, 300);
+    hidden.advance(*gen, 0.01);
+    const MacSimulator::Stats& s2 = hidden.stats();
+    
+    cout << "  → Terminaux cachés : " << s2.transmissions << " émission(s), "
+         << s2.collisions << " collision(s), " << s2.receptions << " réception(s)" << endl;
+    
+    bool test2 = checkCondition("Aucun report : V0 et V2 ne s'entendent pas", s2.deferrals == 0);
+    bool test3 = checkCondition("Les deux trames sont perdues chez V1", s2.collisions == 2 && s2.receptions == 0);
+    bool test4 = checkCondition("Files vidées, plus d'événements en attente",
+                                hidden.queuedPackets() == 0 && hidden.pendingEvents() == 0);
+    
+    bool passed = test1 && test2 && test3 && test4;
+    printTestResult("Couche MAC", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testMacContention() {
+    printTestHeader("Couche MAC : détection de porteuse et backoff");
+    
+    // 20 véhicules tous à portée les uns des autres (une seule clique)
+    InterferenceGraph graph;
+    vector<Vehicule*> vehicles = buildChain(20, 10000.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    // Chacun diffuse 5 trames en même temps : des voisins tirent le même slot
+    MacSimulator clique;
+    for (int k = 0; k < 5; k++) {
+        for (int i = 0; i < 20; i++) clique.send(i, MacSimulator::kBroadcast, 300);
+    }
+    clique.advance(*gen, 1.0);
+    const MacSimulator::Stats& s1 = clique.stats();
+    
+    cout << "  → Clique : " << s1.transmissions << " émission(s), " << s1.deferrals << " report(s), "
+         << s1.collisions << " collision(s), " << s1.halfDuplexLosses << " perte(s) semi-duplex" << endl;
+    
+    bool test1 = checkCondition("Toutes les trames émises", s1.transmissions == 100 && clique.queuedPackets() == 0);
+    bool test2 = checkCondition("Backoffs gelés par le canal occupé", s1.deferrals > 0);
+    bool test3 = checkCondition("Voisins en contention : collisions", s1.collisions > 0);
+    bool test4 = checkCondition("Émetteurs simultanés : pertes semi-duplex", s1.halfDuplexLosses > 0);
+    bool test5 = checkCondition("Chaque trame entendue par les 19 autres",
+                                s1.receptions + s1.collisions + s1.halfDuplexLosses == 100 * 19);
+    
+    // V1 veut émettre pendant une longue trame de V0 : il attend la fin, sans perte
+    vector<Vehicule*> pair = buildChain(2, 250.0);
+    graph.buildGraph(pair);
+    InterferenceGraph::GenerationPtr pairGen = graph.snapshot();
+    MacSimulator deferred;
+    deferred.send(0, 1, 1500);
+    deferred.advance(*pairGen, 0.0005);
+    deferred.send(1, 0, 300);
+    deferred.advance(*pairGen, 0.01);
+    const MacSimulator::Stats& s2 = deferred.stats();
+    
+    bool test6 = checkCondition("Report sans perte quand le canal est perçu",
+                                s2.transmissions == 2 && s2.receptions == 2 &&
+                                s2.unicastDelivered == 2 && s2.collisions == 0 && s2.halfDuplexLosses == 0);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5 && test6;
+    printTestResult("Couche MAC (contention)", passed);
+    
+    cleanupVehicles(vehicles);
+    cleanupVehicles(pair);
+    return passed;
+}
+
+bool InterferenceGraphTest::testPropagationModels() {
+    printTestHeader("Modèles de propagation");
+    
+    // Chaîne V0 - V1 - V2 - V3 (~200m entre voisins) avec une portée de 1m :
+    // aucun lien en disque unité, la portée est ignorée par les modèles à affaiblissement
+    vector<Vehicule*> vehicles = buildChain(4, 1.0);
+    
+    // Bilan par défaut : 23 + 90 - 47.9 dB, n = 2.7 -> ~258m
+    RadioParams radio;
+    InterferenceGraph disk, logDistance, flat, shadowA, shadowB;
+    logDistance.setPropagationModel(PropagationModel::LogDistance, radio);
+    radio.shadowingSigmaDb = 0.0;
+    flat.setPropagationModel(PropagationModel::Shadowing, radio);
+    radio.shadowingSigmaDb = 8.0;
+    radio.seed = 7;
+    shadowA.setPropagationModel(PropagationModel::Shadowing, radio);
+    shadowB.setPropagationModel(PropagationModel::Shadowing, radio);
+    
+    for (InterferenceGraph* g : {&disk, &logDistance, &flat, &shadowA, &shadowB}) {
+        g->buildGraph(vehicles);
+    }
+    
+    cout << "  → Portée log-distance : " << propagation::LogDistance(RadioParams()).maxDistance() << " m" << endl;
+    cout << "  → Liens : disque " << disk.snapshot()->linkCount()
+         << ", log-distance " << logDistance.snapshot()->linkCount()
+         << ", évanouissement " << shadowA.snapshot()->linkCount() << endl;
+    
+    bool test1 = checkCondition("Disque unité : portée de 1m, aucun lien", disk.snapshot()->linkCount() == 0);
+    bool test2 = checkCondition("Log-distance : voisins de la chaîne seulement",
+                                logDistance.snapshot()->linkCount() == 3 && logDistance.canCommunicate(0, 3) &&
+                                logDistance.getVehiclesWithinHops(0, 1) == vector<int>{1});
+    bool test3 = checkCondition("Évanouissement nul = log-distance",
+                                flat.snapshot()->linkCount() == logDistance.snapshot()->linkCount());
+    
+    bool sameLinks = true;
+    for (int i = 0; i < 4; i++) {
+        sameLinks = sameLinks && shadowA.getDirectNeighbors(i) == shadowB.getDirectNeighbors(i);
+    }
+    bool test4 = checkCondition("Même graine : mêmes liens", sameLinks);
+    
+    // Exposant aberrant : portée théorique ~10^16 m, table bornée à kMaxDistance
+    RadioParams extreme;
+    extreme.exponent = 0.5;
+    propagation::Shadowing bounded(extreme);
+    VehicleState a{0, 0.0, 0.0, 1.0}, b{1, 0.0, 0.0, 1.0};
+    RadioParams invalid;
+    invalid.exponent = 0.0;
+    bool test5 = checkCondition("Exposant nul refusé, table bornée pour un exposant aberrant",
+                                !invalid.isValid() && RadioParams().isValid() &&
+                                bounded.linkDistance(a, b) <= propagation::Shadowing::kMaxDistance + 1.0);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Modèles de propagation", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testSinrLinks() {
+    printTestHeader("Liens limités par le SINR");
+    
+    InterferenceGraph graph;
+    
+    // Chaîne V0 - V1 - V2 - V3 (~200m entre voisins, portée 250m)
+    vector<Vehicule*> vehicles = buildChain(4, 250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    SinrModel sinr;
+    vector<pair<int, int>> usable;
+    
+    // V0 seul : seul le bruit limite, ~11 dB à ~200m
+    SinrModel::Stats alone = sinr.evaluate(*gen, {0}, usable);
+    bool test1 = checkCondition("V0 seul : V0 -> V1 utilisable",
+                                alone.usable == 1 && usable == vector<pair<int, int>>{{0, 1}});
+    
+    // V0 et V2 ensemble : V1 reçoit deux signaux de même force ;
+    // V3 entend V2 bien au-dessus de V0, trois fois plus loin
+    SinrModel::Stats both = sinr.evaluate(*gen, {0, 2}, usable);
+    cout << "  → SINR V2 -> V3 : " << sinr.exactSinrDb(*gen, 2, 3) << " dB, V0 -> V1 : "
+         << sinr.exactSinrDb(*gen, 0, 1) << " dB" << endl;
+    
+    bool test2 = checkCondition("V1 brouillé : ni V0 -> V1 ni V2 -> V1",
+                                both.candidates == 3 && both.usable == 1);
+    bool test3 = checkCondition("V2 -> V3 reste utilisable", usable == vector<pair<int, int>>{{2, 3}});
+    
+    // V1 et V2 émettent : chacun est voisin de l'autre (semi-duplex)
+    SinrModel::Stats duplex = sinr.evaluate(*gen, {1, 2}, usable);
+    bool test4 = checkCondition("Un émetteur n'entend pas", duplex.halfDuplex == 2);
+    
+    bool passed = test1 && test2 && test3 && test4;
+    printTestResult("Liens SINR", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testSinrFarField() {
+    printTestHeader("SINR : agrégation hiérarchique du champ lointain");
+    
+    // 800 véhicules sur ~33 x 30 km, 300 émetteurs : plusieurs niveaux de cellules
+    RoadGraph road;
+    mt19937 rng(17);
+    uniform_real_distribution<double> lat(48.45, 48.75);
+    uniform_real_distribution<double> lon(7.55, 7.95);
+    vector<Vehicule*> vehicles;
+    for (int i = 0; i < 800; ++i) {
+        Vertex v = boost::add_vertex(road);
+        road[v].id = long(v);
+        road[v].lat = lat(rng);
+        road[v].lon = lon(rng);
+        vehicles.push_back(new Vehicule(i, road, v, v, 10.0, 1500.0, 5.0));
+    }
+    InterferenceGraph graph;
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    vector<int> transmitters;
+    for (int i = 0; i < 800; i += 8) {
+        transmitters.push_back(i);
+        transmitters.push_back(i + 3);
+        transmitters.push_back(i + 5);
+    }
+    const double thresholdDb = SinrParams().thresholdDb;
+    SinrModel sinr;
+    vector<pair<int, int>> usable;
+    SinrModel::Stats stats = sinr.evaluate(*gen, transmitters, usable);
+    set<pair<int, int>> decoded(usable.begin(), usable.end());
+    
+    // Décision comparée au calcul exact, hors liens à moins de 1 dB du seuil
+    set<int> active(transmitters.begin(), transmitters.end());
+    int compared = 0, wrong = 0;
+    double exactSum = 0.0;
+    for (int t : transmitters) {
+        const int i = gen->indexOf(t);
+        for (const int* it = gen->neighborsBegin(i); it != gen->neighborsEnd(i); ++it) {
+            const int r = gen->idAt(*it);
+            if (active.count(r)) continue;
+            
+            const double exact = sinr.exactSinrDb(*gen, t, r);
+            const bool ok = decoded.count({t, r}) > 0;
+            if (ok) exactSum += exact;
+            if (std::abs(exact - thresholdDb) < 1.0) continue;
+            ++compared;
+            if (ok != (exact >= thresholdDb)) ++wrong;
+        }
+    }
+    const double exactMean = stats.usable ? exactSum / stats.usable : 0.0;
+    cout << "  → " << stats.candidates << " liens candidats, " << stats.usable << " utilisables, SINR moyen "
+         << stats.meanSinrDb() << " dB (exact : " << exactMean << " dB), " << wrong << " décisions erronées sur "
+         << compared << endl;
+    
+    bool test1 = checkCondition("Des liens utilisables et d'autres brouillés",
+                                stats.usable > 0 && stats.usable + stats.halfDuplex < stats.candidates);
+    bool test2 = checkCondition("Même décision que le calcul exact à plus de 1 dB du seuil",
+                                compared > 0 && wrong == 0);
+    bool test3 = checkCondition("SINR moyen à moins de 0,5 dB du calcul exact",
+                                std::abs(stats.meanSinrDb() - exactMean) < 0.5);
+    
+    bool passed = test1 && test2 && test3;
+    printTestResult("SINR champ lointain", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testDirectedLinks() {
+    printTestHeader("Liens orientés et composantes fortement connexes");
+    
+    InterferenceGraph graph;
+    graph.setDirectedLinksEnabled(true);
+    
+    // Chaîne V0 - V1 - V2 (~200m entre voisins) : V1 n'a qu'une portée de 100m
+    // V0 et V2 (500m) atteignent V1 et se joignent mutuellement à ~400m
+    vector<Vehicule*> vehicles = buildChain(3, 500.0);
+    vehicles[1]->setTransmissionRange(100.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr gen = graph.snapshot();
+    
+    cout << "  → Arcs : " << gen->arcCount() << ", liens bidirectionnels : " << gen->linkCount()
+         << ", composantes fortement connexes : " << gen->sccCount() << endl;
+    
+    bool test1 = checkCondition("Arcs V0->V1, V2->V1 et V0<->V2",
+                                gen->arcCount() == 4 && gen->outDegree(gen->indexOf(1)) == 0);
+    bool test2 = checkCondition("Vue bidirectionnelle inchangée : V1 isolé",
+                                gen->linkCount() == 1 && !graph.canCommunicate(0, 1));
+    bool test3 = checkCondition("V0 atteint V1, pas l'inverse", graph.canReach(0, 1) && !graph.canReach(1, 0));
+    bool test4 = checkCondition("Composantes fortement connexes {V0, V2} et {V1}",
+                                gen->sccCount() == 2 && gen->stronglyConnected(0, 2) &&
+                                !gen->stronglyConnected(0, 1));
+    bool test5 = checkCondition("Atteignables depuis V2 : V0 et V1",
+                                gen->getDirectedReachableVehicles(2) == unordered_set<int>{0, 1});
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Liens orientés", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testLinkChanges() {
+    printTestHeader("Changements de liens entre générations");
+    
+    InterferenceGraph graph;
+    graph.setChangeTrackingEnabled(true);
+    
+    // Chaîne V0 - V1 - V2 - V3 (~200m entre voisins)
+    vector<Vehicule*> vehicles = buildChain(4, 250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr first = graph.snapshot();
+    
+    // V1 réduit sa portée : la chaîne éclate en {V0}, {V1}, {V2, V3}
+    vehicles[1]->setTransmissionRange(10.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr second = graph.snapshot();
+    
+    // Tick sans mouvement : aucun changement
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr third = graph.snapshot();
+    
+    // V1 retrouve sa portée : les trois morceaux fusionnent
+    vehicles[1]->setTransmissionRange(250.0);
+    graph.buildGraph(vehicles);
+    InterferenceGraph::GenerationPtr fourth = graph.snapshot();
+    
+    const LinkChanges& split = second->changes();
+    const LinkChanges& merge = fourth->changes();
+    cout << "  → Retirés : " << split.removed.size() << ", scissions : " << split.splits.size()
+         << ", ajoutés : " << merge.added.size() << ", fusions : " << merge.merges.size() << endl;
+    
+    const vector<pair<int, int>> middle{{0, 1}, {1, 2}};
+    bool test1 = checkCondition("Première génération : tous ses liens ajoutés",
+                                first->hasChanges() && first->changes().fromEpoch == 0 &&
+                                first->changes().added.size() == 3 && first->changes().merges.empty());
+    bool test2 = checkCondition("Liens V0-V1 et V1-V2 retirés, rien d'ajouté",
+                                split.fromEpoch == first->epoch() && split.removed == middle && split.added.empty());
+    bool test3 = checkCondition("Une scission en trois morceaux",
+                                split.splits.size() == 1 && split.splits[0].parts.size() == 3 &&
+                                split.merges.empty());
+    bool test4 = checkCondition("Génération inchangée : aucun changement",
+                                third->changes().empty() && third->changes().splits.empty());
+    bool test5 = checkCondition("Liens rétablis : une fusion de trois composantes",
+                                merge.added == middle && merge.removed.empty() && merge.merges.size() == 1 &&
+                                merge.merges[0].parts.size() == 3 &&
+                                merge.merges[0].component == fourth->componentOf(fourth->indexOf(0)));
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Changements de liens", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testKineticLinks() {
+    printTestHeader("Liens cinétiques (certificats de distance)");
+    
+    InterferenceGraph full;
+    InterferenceGraph kinetic;
+    kinetic.setKineticLinksEnabled(true, 300.0);
+    
+    // Deux files de 20 véhicules (~100m entre voisins) qui se croisent à ~10 m/tick
+    const double spacing = 0.0009;
+    const double speed = 0.00009;
+    vector<VehicleState> states;
+    for (int i = 0; i < 20; ++i) {
+        states.push_back({i, 0.0, i * spacing, 150.0});
+        states.push_back({100 + i, 0.003, 0.03 + i * spacing, 250.0});
+    }
+    
+    bool identical = true;
+    long kineticTests = 0;
+    long pairTests = 0;
+    for (int tick = 0; tick < 60; ++tick) {
+        for (VehicleState& s : states) {
+            s.lon += (s.id < 100 ? speed : -speed);
+        }
+        // Au milieu du parcours : un véhicule change de portée, un autre quitte la simulation
+        if (tick == 30) {
+            states[4].range = 400.0;
+            states.pop_back();
+        }
+        
+        full.buildGraph(states);
+        kinetic.buildGraph(states);
+        InterferenceGraph::GenerationPtr a = full.snapshot();
+        InterferenceGraph::GenerationPtr b = kinetic.snapshot();
+        
+        identical = identical && a->linkCount() == b->linkCount();
+        for (int i = 0; identical && i < a->vehicleCount(); ++i) {
+            identical = equal(a->neighborsBegin(i), a->neighborsEnd(i), b->neighborsBegin(i), b->neighborsEnd(i));
+        }
+        kineticTests += kinetic.kineticLinks()->stats().distanceTests;
+        pairTests += long(states.size()) * long(states.size() - 1) / 2;
+    }
+    
+    cout << "  → Calculs de distance : " << kineticTests << " (contre " << pairTests
+         << " en testant toutes les paires)" << endl;
+    
+    bool test1 = checkCondition("Mêmes liens que le test de toutes les paires à chaque tick", identical);
+    bool test2 = checkCondition("Au moins trois fois moins de calculs de distance", 3 * kineticTests < pairTests);
+    
+    kinetic.setKineticLinksEnabled(false);
+    bool test3 = checkCondition("Mode désactivé : plus de moteur cinétique", kinetic.kineticLinks() == nullptr);
+    
+    bool passed = test1 && test2 && test3;
+    printTestResult("Liens cinétiques", passed);
+    
+    return passed;
+}
+
+bool InterferenceGraphTest::testEdgeOccupancy() {
+    printTestHeader("Occupation des arêtes");
+    
+    RoadGraph road;
+    buildRoadGrid(road, 4, 4, 1);
+    vector<Vehicule*> vehicles;
+    for (int i = 0; i < 5; ++i) vehicles.push_back(new Vehicule(i, road, 0, 5, 10.0, 250.0, 5.0));
+    
+    // Place un véhicule sur l'arête orientée from -> to (longueur 0 : arrêté sur un sommet)
+    auto place = [](Vehicule* v, Vertex from, Vertex to, double pos, double length = 200.0) {
+        Vehicule::State s = v->saveState();
+        s.currVertex = uint32_t(from);
+        s.nextVertex = uint32_t(to);
+        s.positionOnEdge = pos;
+        s.edgeLength = length;
+        v->restoreState(s, nullptr);
+    };
+    
+    // V1 < V0 < V2 sur 0 -> 1, V3 en sens inverse, V4 sur 1 -> 2
+    place(vehicles[0], 0, 1, 50.0);
+    place(vehicles[1], 0, 1, 10.0);
+    place(vehicles[2], 0, 1, 120.0);
+    place(vehicles[3], 1, 0, 60.0);
+    place(vehicles[4], 1, 2, 5.0);
+    EdgeOccupancy occupancy;
+    occupancy.update(vehicles);
+    
+    const vector<int>* lane01 = occupancy.lane(0, 1);
+    bool test1 = checkCondition("Arête triée par position, sens séparés",
+                                lane01 && *lane01 == vector<int>{1, 0, 2} &&
+                                occupancy.lane(1, 0) && *occupancy.lane(1, 0) == vector<int>{3} &&
+                                occupancy.lane(2, 1) == nullptr);
+    bool test2 = checkCondition("Tête, suiveur et écart",
+                                occupancy.leaderOf(1) == 0 && occupancy.leaderOf(0) == 2 &&
+                                occupancy.leaderOf(2) == -1 && occupancy.followerOf(0) == 1 &&
+                                occupancy.leaderOf(3) == -1 && occupancy.gapToLeader(1, vehicles) == 40.0 &&
+                                occupancy.gapToLeader(2, vehicles) == EdgeOccupancy::kNoGap);
+    
+    // V2 passe sur 1 -> 2 derrière V4, V1 dépasse V0
+    place(vehicles[2], 1, 2, 2.0);
+    place(vehicles[1], 0, 1, 70.0);
+    place(vehicles[0], 0, 1, 60.0);
+    occupancy.update(vehicles);
+    bool test3 = checkCondition("Changement d'arête et dépassement",
+                                *occupancy.lane(0, 1) == vector<int>{0, 1} &&
+                                *occupancy.lane(1, 2) == vector<int>{2, 4} &&
+                                occupancy.leaderOf(2) == 4 && occupancy.gapToLeader(2, vehicles) == 3.0 &&
+                                occupancy.leaderOf(0) == 1 && occupancy.gapToLeader(0, vehicles) == 10.0 &&
+                                occupancy.leaderOf(1) == -1);
+    
+    // V4 arrive sur un sommet : il quitte l'arête
+    place(vehicles[4], 2, 2, 0.0, 0.0);
+    occupancy.update(vehicles);
+    bool test4 = checkCondition("Véhicule sur un sommet retiré",
+                                *occupancy.lane(1, 2) == vector<int>{2} && occupancy.leaderOf(2) == -1 &&
+                                occupancy.followerOf(4) == -1);
+    
+    // Anti-collision : ralentit si trop près, puis revient vers la vitesse désirée
+    Vehicule* v = vehicles[0];
+    v->avoidCollision(2.0);
+    const bool slowed = v->getSpeed() < v->getDesiredSpeed();
+    for (int t = 0; t < 40; ++t) v->avoidCollision(EdgeOccupancy::kNoGap);
+    v->setSpeed(0.0);
+    v->avoidCollision(EdgeOccupancy::kNoGap);
+    const bool restarts = v->getSpeed() > 0.0;
+    for (int t = 0; t < 60; ++t) v->avoidCollision(100.0);
+    bool test5 = checkCondition("Anti-collision : ralentit puis récupère (même à l'arrêt)",
+                                slowed && restarts && v->getSpeed() > 0.99 * v->getDesiredSpeed() &&
+                                v->getSpeed() <= v->getDesiredSpeed());
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Occupation des arêtes", passed);
+    
+    cleanupVehicles(vehicles);
+    return passed;
+}
+
+bool InterferenceGraphTest::testRoutePlanner() {
+    printTestHeader("Itinéraires A* et cache partagé");
+    
+    RoadGraph road;
+    buildRoadGrid(road, 12, 12, 3);
+    const Vertex n = Vertex(boost::num_vertices(road));
+    RoutePlanner planner(road, 64);
+    
+    // Paires aléatoires (îlot et sommet isolé compris) comparées à Dijkstra
+    mt19937 rng(11);
+    int shortest = 0, reachable = 0, rejected = 0, unreachable = 0;
+    for (int k = 0; k < 300; ++k) {
+        const Vertex o = rng() % n;
+        const Vertex d = rng() % n;
+        const double expected = referenceDistance(road, o, d);
+        RoutePlanner::Route r = planner.route(o, d);
+        if (std::isinf(expected)) {
+            ++unreachable;
+            if (!r) ++rejected;
+        } else {
+            ++reachable;
+            if (r && r->front() == o && r->back() == d &&
+                std::abs(routeLength(road, *r) - expected) <= 1e-6 * (1.0 + expected)) {
+                ++shortest;
+            }
+        }
+    }
+    cout << "  → " << reachable << " paires accessibles, " << unreachable << " inaccessibles" << endl;
+    
+    // Espace de travail par thread : un graphe d'une autre taille entre deux requêtes
+    RoadGraph small;
+    buildRoadGrid(small, 3, 3, 5);
+    RoutePlanner other(small);
+    other.route(0, 8);
+    planner.clearCache();
+    RoutePlanner::Route corner = planner.route(0, n - 6);
+    const bool workspaceReused = corner &&
+        std::abs(routeLength(road, *corner) - referenceDistance(road, 0, n - 6)) <= 1e-6 * routeLength(road, *corner);
+    
+    // Cache : une absence puis un succès partagé, y compris pour une destination inaccessible
+    planner.clearCache();
+    const size_t hits = planner.cacheHits();
+    const size_t misses = planner.cacheMisses();
+    RoutePlanner::Route first = planner.route(1, 50);
+    RoutePlanner::Route again = planner.route(1, 50);
+    RoutePlanner::Route island = planner.route(1, n - 2);
+    RoutePlanner::Route islandAgain = planner.route(1, n - 2);
+    const bool counted = planner.cacheMisses() == misses + 2 && planner.cacheHits() == hits + 2;
+    
+    // Capacité : l'entrée la moins récemment utilisée est évincée
+    RoutePlanner tiny(road, 2);
+    tiny.route(0, 10);
+    tiny.route(0, 20);
+    tiny.route(0, 10);
+    tiny.route(0, 30);  // évince (0, 20)
+    tiny.route(0, 10);
+    tiny.route(0, 20);
+    const bool evicted = tiny.cacheHits() == 2 && tiny.cacheMisses() == 4;
+    
+    bool test1 = checkCondition("Itinéraires les plus courts (comparés à Dijkstra)",
+                                reachable > 0 && shortest == reachable);
+    bool test2 = checkCondition("Destinations inaccessibles refusées", unreachable > 0 && rejected == unreachable);
+    bool test3 = checkCondition("Espace de travail réutilisé après un autre graphe", workspaceReused);
+    bool test4 = checkCondition("Cache : itinéraire partagé, absences et succès comptés",
+                                first && first == again && !island && !islandAgain && counted);
+    bool test5 = checkCondition("Cache LRU borné : éviction de l'entrée la plus ancienne", evicted);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Itinéraires A*", passed);
+    return passed;
+}
+
+bool InterferenceGraphTest::testContractionHierarchy() {
+    printTestHeader("Hiérarchie de contraction");
+    
+    RoadGraph road;
+    buildRoadGrid(road, 15, 15, 7);
+    const Vertex n = Vertex(boost::num_vertices(road));
+    ContractionHierarchy ch;
+    ch.build(road);
+    cout << "  → " << ch.arcCount() << " arcs montants dont " << ch.shortcutCount() << " raccourcis" << endl;
+    
+    // Paires aléatoires : distances et itinéraires dépliés comparés à Dijkstra
+    mt19937 rng(13);
+    vector<pair<Vertex, Vertex>> pairs;
+    for (int k = 0; k < 300; ++k) pairs.push_back({Vertex(rng() % n), Vertex(rng() % n)});
+    pairs.push_back({0, n - 1});    // sommet relié par un chemin piéton seulement
+    pairs.push_back({n - 2, 5});    // îlot
+    
+    int matched = 0, unreachable = 0;
+    vector<Vertex> path;
+    for (const auto& [o, d] : pairs) {
+        const double expected = referenceDistance(road, o, d);
+        const double got = ch.distance(o, d);
+        const bool found = ch.route(o, d, path);
+        if (std::isinf(expected)) {
+            ++unreachable;
+            if (std::isinf(got) && !found) ++matched;
+        } else if (found && path.front() == o && path.back() == d &&
+                   std::abs(got - expected) <= 1e-6 * (1.0 + expected) &&
+                   std::abs(routeLength(road, path) - expected) <= 1e-6 * (1.0 + expected)) {
+            ++matched;
+        }
+    }
+    
+    // Table plusieurs-à-plusieurs
+    const vector<Vertex> sources = {0, 17, 100, n - 2};
+    const vector<Vertex> targets = {3, 50, 224, n - 1, n - 3};
+    const vector<double> table = ch.distanceTable(sources, targets);
+    bool tableMatches = table.size() == sources.size() * targets.size();
+    for (size_t i = 0; tableMatches && i < sources.size(); ++i) {
+        for (size_t j = 0; j < targets.size(); ++j) {
+            const double expected = referenceDistance(road, sources[i], targets[j]);
+            const double got = table[i * targets.size() + j];
+            tableMatches = tableMatches && (std::isinf(expected) ? std::isinf(got)
+                                                                : std::abs(got - expected) <= 1e-6 * (1.0 + expected));
+        }
+    }
+    
+    // Sauvegarde et relecture ; un fichier aux rangs incohérents est refusé
+    const string file = (std::filesystem::temp_directory_path() / "v2v_test.ch").string();
+    ContractionHierarchy loaded;
+    const bool reloaded = ch.save(file) && loaded.load(file, road) &&
+                          loaded.distance(0, 100) == ch.distance(0, 100);
+    {
+        fstream f(file, ios::in | ios::out | ios::binary);
+        const uint32_t duplicate = 0;
+        f.seekp(8 + 4 + 8 + 3 * 8 + sizeof(uint32_t));     // en-tête, puis rang du sommet 1
+        f.write(reinterpret_cast<const char*>(&duplicate), sizeof(duplicate));
+        f.seekp(8 + 4 + 8 + 3 * 8);                        // rang du sommet 0
+        f.write(reinterpret_cast<const char*>(&duplicate), sizeof(duplicate));
+    }
+    ContractionHierarchy corrupt;
+    const bool rejected = !corrupt.load(file, road) && !corrupt.isReady();
+    std::remove(file.c_str());
+    
+    // Planificateur : la hiérarchie remplace A* à distances égales
+    RoutePlanner planner(road);
+    planner.setContractionHierarchy(&ch);
+    RoutePlanner::Route r = planner.route(0, 200);
+    const bool plannerUsesCh = r && std::abs(routeLength(road, *r) - referenceDistance(road, 0, 200)) <= 1e-6 * 200000.0;
+    
+    bool test1 = checkCondition("Distances et itinéraires identiques à Dijkstra",
+                                matched == int(pairs.size()));
+    bool test2 = checkCondition("Paires inaccessibles (îlot, chemin piéton) : +inf", unreachable >= 2);
+    bool test3 = checkCondition("Table plusieurs-à-plusieurs", tableMatches);
+    bool test4 = checkCondition("Sauvegarde et relecture", reloaded);
+    bool test5 = checkCondition("Fichier corrompu refusé", rejected);
+    bool test6 = checkCondition("RoutePlanner sur la hiérarchie", plannerUsesCh);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5 && test6;
+    printTestResult("Hiérarchie de contraction", passed);
+    return passed;
+}
+
+bool InterferenceGraphTest::testCheckpointRoundTrip() {
+    printTestHeader("Reprise exacte après un point de contrôle");
+    
+    RoadGraph road;
+    buildRoadGrid(road, 12, 12, 3);
+    const int n = int(boost::num_vertices(road)) - 4;   // hors îlot et sommet piéton
+    RoutePlanner planner(road);
+    
+    // Pas fixes seulement : en mode minuterie, dt vient de l'horloge murale
+    const double step = 0.5;
+    const int ticks = 60;
+    const string file = (std::filesystem::temp_directory_path() / "v2v_test.ckpt").string();
+    
+    auto states = [](const Simulator& sim) {
+        vector<double> out;
+        for (const Vehicule* v : sim.vehicles()) {
+            auto [lat, lon] = v->getPosition();
+            out.insert(out.end(), {double(v->getId()), lat, lon, v->getSpeed()});
+        }
+        return out;
+    };
+    
+    Simulator original(road, nullptr, nullptr, Simulator::ThreadMode::Caller);
+    original.setSeed(11);
+    mt19937 rng(5);
+    for (int i = 0; i < 30; ++i) {
+        original.setRoutePlanner(i % 2 ? &planner : nullptr);
+        original.addVehicle(new Vehicule(i, road, Vertex(rng() % n), Vertex(rng() % n), 14.0, 300.0, 5.0));
+    }
+    original.setRoutePlanner(&planner);
+    original.setDirectedLinksEnabled(true);
+    original.setLinkChangeTrackingEnabled(true);
+    for (int t = 0; t < ticks; ++t) original.advance(step);
+    const bool saved = original.saveCheckpoint(file);
+    for (int t = 0; t < ticks; ++t) original.advance(step);
+    
+    Simulator restored(road, nullptr, nullptr, Simulator::ThreadMode::Caller);
+    restored.setRoutePlanner(&planner);
+    const bool loaded = restored.loadCheckpoint(file);
+    for (int t = 0; t < ticks; ++t) restored.advance(step);
+    
+    // Paramètres radio invalides (exposant nul) : le fichier est refusé, l'état conservé
+    RadioParams invalid;
+    invalid.exponent = 0.0;
+    original.setPropagationModel(PropagationModel::Shadowing, invalid);
+    const bool rejected = original.saveCheckpoint(file) && !restored.loadCheckpoint(file) &&
+                          restored.vehicles().size() == original.vehicles().size();
+    std::remove(file.c_str());
+    
+    const vector<double> expected = states(original);
+    const vector<double> got = states(restored);
+    int mismatches = 0;
+    for (size_t i = 0; i < min(expected.size(), got.size()); ++i) {
+        if (expected[i] != got[i]) ++mismatches;
+    }
+    cout << "  → " << original.vehicles().size() << " véhicules, " << mismatches << " valeurs différentes" << endl;
+    
+    bool test1 = checkCondition("Sauvegarde et chargement", saved && loaded);
+    bool test2 = checkCondition("Même compteur de ticks et temps simulé",
+                                restored.tickCount() == original.tickCount() &&
+                                restored.simulationTime() == original.simulationTime());
+    bool test3 = checkCondition("États des véhicules identiques après " + to_string(ticks) + " pas",
+                                !expected.empty() && expected.size() == got.size() && mismatches == 0);
+    
+    bool test4 = checkCondition("Paramètres radio invalides refusés", rejected);
+    bool test5 = checkCondition("Mode orienté restauré", restored.interferenceGraph().directedLinksEnabled());
+    bool test6 = checkCondition("Suivi des changements restauré", restored.interferenceGraph().changeTrackingEnabled());
+    
+    bool passed = test1 && test2 && test3 && test4 && test5 && test6;
+    printTestResult("Reprise exacte après un point de contrôle", passed);
+    return passed;
+}
+
+bool InterferenceGraphTest::testEventModeRestart() {
+    printTestHeader("Passage en mode événementiel");
+    
+    RoadGraph road;
+    buildRoadGrid(road, 8, 8, 5);
+    Simulator sim(road, nullptr, nullptr, Simulator::ThreadMode::Caller);
+    sim.addVehicle(new Vehicule(0, road, 0, 20, 14.0, 300.0, 5.0));
+    sim.addVehicle(new Vehicule(1, road, 9, 30, 14.0, 300.0, 5.0));
+    sim.advance(0.5);
+    
+    // Véhicule arrêté (comme par le suivi de véhicule) au moment du passage
+    sim.vehicles()[0]->setSpeed(0.0);
+    sim.setEventDrivenEnabled(true);
+    const auto before = sim.vehicles()[0]->getPosition();
+    for (int t = 0; t < 20; ++t) sim.advance(0.5);
+    const auto after = sim.vehicles()[0]->getPosition();
+    
+    bool test1 = checkCondition("Vitesse désirée rétablie", sim.vehicles()[0]->getSpeed() == sim.vehicles()[0]->getDesiredSpeed());
+    bool test2 = checkCondition("Le véhicule arrêté repart", before != after);
+    
+    bool passed = test1 && test2;
+    printTestResult("Passage en mode événementiel", passed);
+    return passed;
+}
+
+bool InterferenceGraphTest::testTrajectoryTrace() {
+    printTestHeader("Trace des trajectoires");
+    
+    // 40 frames aux ticks 3, 5, ..., 81, nombre de véhicules variable, blocs de 8 frames
+    vector<SimulationSnapshot> frames(40);
+    for (int k = 0; k < 40; ++k) {
+        frames[k].tick = 3 + 2 * k;
+        frames[k].simTime = frames[k].tick * 0.05;
+        for (int i = 0; i < 5 + k % 4; ++i) {
+            frames[k].vehicles.push_back({3 * i, 48.57 + 1e-4 * k + 1e-5 * i, 7.75 - 2e-4 * k + 3e-5 * i, 250.0 + i});
+        }
+    }
+    // Positions quantifiées à 1e-7 degré, portée au centimètre
+    auto sameFrame = [](const SimulationSnapshot& a, const SimulationSnapshot& b) {
+        if (a.tick != b.tick || a.simTime != b.simTime || a.vehicles.size() != b.vehicles.size()) return false;
+        for (size_t i = 0; i < a.vehicles.size(); ++i) {
+            const VehicleState& u = a.vehicles[i];
+            const VehicleState& v = b.vehicles[i];
+            if (u.id != v.id || std::abs(u.lat - v.lat) > 1e-7 || std::abs(u.lon - v.lon) > 1e-7 ||
+                std::abs(u.range - v.range) > 0.01) return false;
+        }
+        return true;
+    };
+    
+    const string file = (std::filesystem::temp_directory_path() / "v2v_test.trace").string();
+    const string truncatedFile = file + ".part";
+    TraceWriter writer;
+    bool written = writer.open(file, 8);
+    for (const auto& f : frames) written = written && writer.append(f);
+    const bool rejectsOlder = !writer.append(frames[10]) && !writer.append(frames.back());
+    written = writer.close() && written;
+    
+    // Relecture de toutes les frames, avec index (5 blocs)
+    TraceReader reader;
+    bool roundTrip = written && reader.open(QString::fromStdString(file)) &&
+                     reader.firstTick() == 3 && reader.lastTick() == 81;
+    SimulationSnapshot out;
+    for (const auto& f : frames) {
+        roundTrip = roundTrip && reader.readFrame(f.tick, out) && sameFrame(out, f);
+    }
+    
+    // Accès direct au milieu d'un bloc, puis en arrière ; un tick absent donne la frame précédente
+    const bool seekMiddle = reader.readFrame(41, out) && sameFrame(out, frames[19]);
+    const bool seekBack = reader.readFrame(10, out) && sameFrame(out, frames[3]);
+    const bool beforeFirst = !reader.readFrame(2, out);
+    reader.close();
+    
+    // Trace interrompue : sans index et avec un dernier bloc incomplet
+    {
+        ifstream in(file, ios::binary);
+        const string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        ofstream cut(truncatedFile, ios::binary | ios::trunc);
+        cut.write(bytes.data(), streamsize(bytes.size() * 9 / 10));
+    }
+    TraceReader partial;
+    bool scanned = partial.open(QString::fromStdString(truncatedFile)) && !partial.isEmpty() &&
+                   partial.firstTick() == 3 && partial.lastTick() < 81;
+    int partialFrames = 0;
+    for (const auto& f : frames) {
+        if (!scanned || f.tick > partial.lastTick()) break;
+        scanned = partial.readFrame(f.tick, out) && sameFrame(out, f);
+        ++partialFrames;
+    }
+    scanned = scanned && partialFrames % 8 == 0 && partial.readFrame(81, out) && out.tick == partial.lastTick();
+    partial.close();
+    std::remove(file.c_str());
+    std::remove(truncatedFile.c_str());
+    
+    cout << "  → Trace interrompue : " << partialFrames << " frame(s) sur 40 relues" << endl;
+    
+    bool test1 = checkCondition("Aller-retour sur plusieurs blocs", roundTrip);
+    bool test2 = checkCondition("Tick non croissant refusé", rejectsOlder);
+    bool test3 = checkCondition("Accès direct au milieu d'un bloc", seekMiddle);
+    bool test4 = checkCondition("Retour en arrière (tick absent : frame précédente)", seekBack && beforeFirst);
+    bool test5 = checkCondition("Trace sans index : blocs complets réindexés", scanned);
+    
+    bool passed = test1 && test2 && test3 && test4 && test5;
+    printTestResult("Trace des trajectoires", passed);
+    return passed;
+}
+
+bool InterferenceGraphTest::testTraceReplayModel() {
+    printTestHeader("Relecture sous le modèle enregistré");
+    
+    // Chaîne à portée de 1m : liens en log-distance seulement
+    vector<Vehicule*> vehicles = buildChain(4, 1.0);
+    SimulationSnapshot frame;
+    for (const Vehicule* v : vehicles) {
+        auto [lat, lon] = v->getPosition();
+        frame.vehicles.push_back({v->getId(), lat, lon, v->getTransmissionRange()});
+    }
+    
+    const string file = (std::filesystem::temp_directory_path() / "v2v_test_model.trace").string();
+    RadioParams radio;
+    radio.txPowerDbm = 22.0;
+    TraceWriter writer;
+    bool written = writer.open(file, 8, PropagationModel::LogDistance, radio) && writer.append(frame) && writer.close();
+    
+    TraceReplay replay;
+    const bool opened = written && replay.open(QString::fromStdString(file));
+    auto snap = replay.snapshot();
+    const InterferenceGraph& g = replay.interferenceGraph();
+    
+    bool test1 = checkCondition("Trace ouverte", opened && snap != nullptr);
+    bool test2 = checkCondition("Modèle et paramètres radio repris de l'en-tête",
+                                g.propagationModel() == PropagationModel::LogDistance &&
+                                g.radioParams().txPowerDbm == 22.0);
+    bool test3 = checkCondition("Liens recalculés en log-distance", snap && snap->links.size() == 3);
+    
+    replay.close();
+    std::remove(file.c_str());
+    cleanupVehicles(vehicles);
+    
+    bool passed = test1 && test2 && test3;
+    printTestResult("Relecture sous le modèle enregistré", passed);
+    return passed;
+}
+
 bool InterferenceGraphTest::runAllTests() {
     cout << "\n";
     cout << "╔════════════════════════════════════════════════════════════╗" << endl;
@@ -450,6 +1622,26 @@ bool InterferenceGraphTest::runAllTests() {
     testAsymmetricRange();
     testCompleteGraph();
     testStarTopology();
+    testGenerationSnapshot();
+    testDissemination();
+    testHopLimitedReachability();
+    testShortestHopPath();
+    testGeographicForwarding();
+    testMacCollisions();
+    testMacContention();
+    testPropagationModels();
+    testSinrLinks();
+    testSinrFarField();
+    testDirectedLinks();
+    testLinkChanges();
+    testKineticLinks();
+    testEdgeOccupancy();
+    testRoutePlanner();
+    testContractionHierarchy();
+    testCheckpointRoundTrip();
+    testEventModeRestart();
+    testTrajectoryTrace();
+    testTraceReplayModel();
     
     return m_failedTests == 0;
 }
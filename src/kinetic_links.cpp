@@ -0,0 +1,130 @@
+#include "kinetic_links.h"
+
+#include <algorithm>
+
+KineticLinks::KineticLinks(double horizon)
+    : m_horizon(horizon),
+      // Échéances en mètres d'odomètre : quelques dizaines de centimètres par seau
+      m_events(0.5, 1024) {}
+
+void KineticLinks::clear() {
+    m_slots.clear();
+    m_slotOf.clear();
+    m_freeSlots.clear();
+    m_active.clear();
+    m_toScan.clear();
+    m_pairs.clear();
+    m_freePairs.clear();
+    m_events.clear();
+    m_odometer = 0.0;
+    m_tick = 0;
+    m_stats = Stats();
+}
+
+void KineticLinks::bind(const std::vector<VehicleState>& states) {
+    if (++m_tick == 0) {
+        for (Slot& s : m_slots) s.scanStamp = 0;
+        m_tick = 1;
+    }
+
+    for (uint32_t slot : m_active) {
+        m_slots[slot].index = -1;
+    }
+    std::vector<uint32_t> previous;
+    previous.swap(m_active);
+    m_toScan.clear();
+
+    double maxStep = 0.0;
+    for (int i = 0; i < int(states.size()); ++i) {
+        const VehicleState& st = states[i];
+        auto [it, inserted] = m_slotOf.emplace(st.id, 0);
+
+        if (inserted) {
+            // Nouveau véhicule : slot recyclé ou ajouté, balayage complet
+            uint32_t slot;
+            if (!m_freeSlots.empty()) {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            } else {
+                slot = uint32_t(m_slots.size());
+                m_slots.emplace_back();
+            }
+            it->second = slot;
+            Slot& s = m_slots[slot];
+            s.id = st.id;
+            s.lat = st.lat;
+            s.lon = st.lon;
+            s.range = st.range;
+            s.odometer = 0.0;
+            s.scannedAt = 0.0;
+            s.scanStamp = 0;
+            m_toScan.push_back(slot);
+        } else {
+            Slot& s = m_slots[it->second];
+            const double step = GraphBuilder::distance(s.lat, s.lon, st.lat, st.lon);
+            s.odometer += step;
+            maxStep = std::max(maxStep, step);
+            s.lat = st.lat;
+            s.lon = st.lon;
+
+            // Portée modifiée (seuils de toutes ses paires) ou horizon à moitié parcouru
+            if (st.range != s.range || s.odometer - s.scannedAt >= 0.5 * m_horizon) {
+                s.range = st.range;
+                m_toScan.push_back(it->second);
+            }
+        }
+
+        m_slots[it->second].index = i;
+        m_active.push_back(it->second);
+    }
+    m_odometer += maxStep;
+
+    for (uint32_t slot : previous) {
+        if (m_slots[slot].index == -1) release(slot);
+    }
+}
+
+void KineticLinks::release(uint32_t slot) {
+    Slot& s = m_slots[slot];
+    while (!s.partners.empty()) {
+        erasePair(s.partners.back().second);
+    }
+    m_slotOf.erase(s.id);
+    s.id = -1;
+    m_freeSlots.push_back(slot);
+}
+
+uint32_t KineticLinks::addPair(uint32_t a, uint32_t b) {
+    uint32_t p;
+    if (!m_freePairs.empty()) {
+        p = m_freePairs.back();
+        m_freePairs.pop_back();
+    } else {
+        p = uint32_t(m_pairs.size());
+        m_pairs.emplace_back();
+    }
+    m_pairs[p].a = a;
+    m_pairs[p].b = b;
+    m_slots[a].partners.push_back({b, p});
+    m_slots[b].partners.push_back({a, p});
+    return p;
+}
+
+void KineticLinks::erasePair(uint32_t p) {
+    // Ses événements deviennent périmés (entrée libre, puis nouveau numéro si elle est reprise)
+    for (uint32_t self : {m_pairs[p].a, m_pairs[p].b}) {
+        auto& partners = m_slots[self].partners;
+        auto it = std::find_if(partners.begin(), partners.end(),
+                               [p](const std::pair<uint32_t, uint32_t>& entry) { return entry.second == p; });
+        *it = partners.back();
+        partners.pop_back();
+    }
+    m_pairs[p].a = kNone;
+    m_freePairs.push_back(p);
+}
+
+void KineticLinks::schedule(uint32_t p, double remaining) {
+    // Chaque véhicule parcourt au plus l'avance de l'odomètre : la paire au plus le double
+    m_pairs[p].seq = m_nextSeq;
+    m_events.push({m_odometer + 0.5 * remaining, m_nextSeq++, p});
+}
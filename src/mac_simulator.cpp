@@ -0,0 +1,287 @@
+#include "mac_simulator.h"
+
+#include <algorithm>
+
+MacSimulator::MacSimulator(const MacParams& params, uint32_t seed)
+    : m_params(params),
+      m_rng(seed),
+      // Seaux de l'ordre d'un slot de backoff, fenêtre de quelques dizaines de ms
+      m_events(params.slotTime, 4096) {}
+
+uint32_t MacSimulator::nodeOf(int vehicleId) {
+    auto it = m_nodeOf.find(vehicleId);
+    if (it != m_nodeOf.end()) return it->second;
+
+    uint32_t node = uint32_t(m_nodes.size());
+    Node n;
+    n.vehicleId = vehicleId;
+    n.cw = m_params.cwMin;
+    m_nodes.push_back(n);
+    m_nodeToIndex.push_back(-1);
+    m_nodeOf.emplace(vehicleId, node);
+    return node;
+}
+
+void MacSimulator::bind(const InterferenceGraph::Generation& gen) {
+    if (m_gen == &gen && m_epoch == gen.epoch()) return;
+
+    for (uint32_t node : m_indexToNode) {
+        m_nodeToIndex[node] = -1;
+    }
+
+    const int n = gen.vehicleCount();
+    m_indexToNode.resize(n);
+    for (int i = 0; i < n; ++i) {
+        uint32_t node = nodeOf(gen.idAt(i));
+        m_indexToNode[i] = node;
+        m_nodeToIndex[node] = i;
+    }
+
+    // Balises : premier envoi à une phase aléatoire pour les véhicules (re)venus
+    if (m_params.beaconInterval > 0.0) {
+        std::uniform_real_distribution<double> phase(0.0, m_params.beaconInterval);
+        for (uint32_t node : m_indexToNode) {
+            if (!m_nodes[node].beaconing) {
+                m_nodes[node].beaconing = true;
+                schedule(m_now + phase(m_rng), EventType::Beacon, node);
+            }
+        }
+    }
+
+    m_gen = &gen;
+    m_epoch = gen.epoch();
+}
+
+uint64_t MacSimulator::schedule(double time, EventType type, uint32_t target) {
+    m_events.push({time, m_nextSeq, type, target});
+    return m_nextSeq++;
+}
+
+void MacSimulator::scheduleAccess(uint32_t node) {
+    Node& n = m_nodes[node];
+    if (n.accessPending || n.transmitting || n.queued == 0) return;
+    // Canal occupé : le décompte reprendra quand il se libère (onTxEnd)
+    if (n.heard > 0) return;
+
+    if (n.backoff < 0) {
+        std::uniform_int_distribution<int> backoff(0, n.cw);
+        n.backoff = backoff(m_rng);
+    }
+    n.accessPending = true;
+    n.countStart = m_now;
+    n.accessTime = m_now + m_params.difs + n.backoff * m_params.slotTime;
+    n.accessSeq = schedule(n.accessTime, EventType::Access, node);
+}
+
+void MacSimulator::freezeBackoff(uint32_t node) {
+    Node& n = m_nodes[node];
+
+    // Trame commencée moins d'un slot avant l'accès : pas encore perçue, le nœud émet
+    // (1 ns de marge pour les arrondis sur les multiples du slot)
+    if (n.accessTime - m_now < m_params.slotTime - 1e-9) return;
+
+    // Slots entiers déjà décomptés après le DIFS ; l'Access programmé devient périmé
+    const double counted = m_now - n.countStart - m_params.difs;
+    if (counted > 0.0) n.backoff = std::max(0, n.backoff - int(counted / m_params.slotTime + 1e-9));
+    n.accessPending = false;
+    m_stats.deferrals++;
+}
+
+uint32_t MacSimulator::allocPacket() {
+    if (m_freePacket != kNone) {
+        uint32_t p = m_freePacket;
+        m_freePacket = m_packets[p].next;
+        return p;
+    }
+    m_packets.push_back(Packet());
+    return uint32_t(m_packets.size() - 1);
+}
+
+void MacSimulator::freePacket(uint32_t p) {
+    m_packets[p].next = m_freePacket;
+    m_freePacket = p;
+}
+
+uint32_t MacSimulator::allocTransmission() {
+    if (m_freeTransmission != kNone) {
+        uint32_t t = m_freeTransmission;
+        m_freeTransmission = m_transmissions[t].nextFree;
+        m_transmissions[t].receivers.clear();   // la capacité est conservée
+        return t;
+    }
+    m_transmissions.push_back(Transmission());
+    return uint32_t(m_transmissions.size() - 1);
+}
+
+bool MacSimulator::enqueue(uint32_t node, int destination, uint32_t bytes) {
+    if (m_nodes[node].queued >= m_params.queueLimit) {
+        m_stats.queueDrops++;
+        return false;
+    }
+
+    uint32_t p = allocPacket();
+    m_packets[p] = {destination, bytes, m_now, kNone};
+
+    Node& n = m_nodes[node];
+    if (n.tail == kNone) {
+        n.head = p;
+    } else {
+        m_packets[n.tail].next = p;
+    }
+    n.tail = p;
+    n.queued++;
+    m_queuedPackets++;
+    m_stats.enqueued++;
+
+    scheduleAccess(node);
+    return true;
+}
+
+bool MacSimulator::send(int sourceId, int destinationId, uint32_t bytes) {
+    return enqueue(nodeOf(sourceId), destinationId, bytes);
+}
+
+void MacSimulator::onAccess(uint32_t node) {
+    Node& n = m_nodes[node];
+    n.accessPending = false;
+    if (n.transmitting || n.queued == 0) return;
+
+    // Retirer la tête de file
+    uint32_t p = n.head;
+    n.head = m_packets[p].next;
+    if (n.head == kNone) n.tail = kNone;
+    n.queued--;
+    m_queuedPackets--;
+    n.backoff = -1;
+    n.transmitting = true;
+
+    // Semi-duplex : la trame que ce nœud recevait est perdue parce qu'il émet,
+    // comptée comme telle à sa fin (sauf si une collision l'avait déjà perdue)
+    if (n.locked != kNone) {
+        if (!n.corrupted) {
+            std::vector<uint32_t>& receivers = m_transmissions[n.locked].receivers;
+            std::replace(receivers.begin(), receivers.end(), node, node | kHalfDuplex);
+        }
+        n.locked = kNone;
+    }
+
+    m_stats.transmissions++;
+    m_stats.sumAccessDelay += m_now - m_packets[p].enqueueTime;
+
+    uint32_t t = allocTransmission();
+    Transmission& tx = m_transmissions[t];
+    tx.packet = p;
+    tx.source = node;
+
+    // Récepteurs : voisins directs dans la génération courante
+    const int index = m_nodeToIndex[node];
+    if (index >= 0) {
+        for (const int* it = m_gen->neighborsBegin(index); it != m_gen->neighborsEnd(index); ++it) {
+            const uint32_t r = m_indexToNode[*it];
+            Node& rn = m_nodes[r];
+            rn.heard++;
+            if (rn.heard == 1 && rn.accessPending) freezeBackoff(r);
+
+            if (rn.transmitting) {
+                tx.receivers.push_back(r | kHalfDuplex);
+                continue;
+            }
+            tx.receivers.push_back(r);
+            if (rn.heard == 1) {
+                rn.locked = t;
+                rn.corrupted = false;
+            } else if (rn.locked != kNone) {
+                rn.corrupted = true;    // chevauchement : la trame en cours est perdue aussi
+            }
+        }
+    }
+
+    schedule(m_now + airtime(m_packets[p].bytes), EventType::TxEnd, t);
+}
+
+void MacSimulator::onTxEnd(uint32_t t) {
+    Transmission& tx = m_transmissions[t];
+    const Packet& packet = m_packets[tx.packet];
+    bool delivered = false;
+
+    for (uint32_t entry : tx.receivers) {
+        const uint32_t r = entry & ~kHalfDuplex;
+        Node& rn = m_nodes[r];
+        rn.heard--;
+
+        if (entry & kHalfDuplex) {
+            m_stats.halfDuplexLosses++;
+        } else if (rn.locked == t) {
+            if (rn.corrupted) {
+                m_stats.collisions++;
+            } else {
+                m_stats.receptions++;
+                if (packet.destination == rn.vehicleId) {
+                    m_stats.unicastDelivered++;
+                    delivered = true;
+                }
+            }
+            rn.locked = kNone;
+        } else {
+            m_stats.collisions++;       // arrivée pendant une autre réception
+        }
+
+        // Canal de nouveau libre : le backoff gelé reprend après DIFS
+        if (rn.heard == 0) scheduleAccess(r);
+    }
+
+    // Acquittement implicite : fenêtre doublée après une trame unicast perdue
+    Node& source = m_nodes[tx.source];
+    if (packet.destination != kBroadcast && !delivered) {
+        source.cw = std::min(2 * source.cw + 1, m_params.cwMax);
+    } else {
+        source.cw = m_params.cwMin;
+    }
+
+    const uint32_t sourceNode = tx.source;
+    freePacket(tx.packet);
+    tx.nextFree = m_freeTransmission;
+    m_freeTransmission = t;
+
+    source.transmitting = false;
+    scheduleAccess(sourceNode);
+}
+
+void MacSimulator::onBeacon(uint32_t node) {
+    // Véhicule sorti de la simulation : les balises reprendront à son retour
+    if (m_nodeToIndex[node] < 0) {
+        m_nodes[node].beaconing = false;
+        return;
+    }
+
+    enqueue(node, kBroadcast, m_params.beaconBytes);
+    schedule(m_now + m_params.beaconInterval, EventType::Beacon, node);
+}
+
+void MacSimulator::advance(const InterferenceGraph::Generation& gen, double duration) {
+    bind(gen);
+
+    const double end = m_now + duration;
+    Event e;
+    while (m_events.pop(e)) {
+        if (e.time > end) {
+            m_events.push(e);   // même numéro d'ordre : rien ne change
+            break;
+        }
+
+        m_now = e.time;
+        m_stats.events++;
+        switch (e.type) {
+        case EventType::Access:
+            if (m_nodes[e.target].accessPending && m_nodes[e.target].accessSeq == e.seq) onAccess(e.target);
+            break;
+        case EventType::TxEnd:
+            onTxEnd(e.target);
+            break;
+        case EventType::Beacon:
+            onBeacon(e.target);
+            break;
+        }
+    }
+    m_now = end;
+}
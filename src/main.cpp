@@ -7,6 +7,9 @@
 
 #include "map_view.h"
 #include "simulator.h"
+#include "route_planner.h"
+#include "contraction_hierarchy.h"
+#include "parameter_sweep.h"
 #include "graph_builder.h"
 #include "osm_reader.h"
 #include "interference_graph_test.h"
@@ -37,7 +40,8 @@ int main(int argc, char** argv){
 
     // ----------------------
     //  Load OSM data
-    OSMReader reader("../data/strasbourg.osm.pbf");
+    const std::string osmFile = "../data/strasbourg.osm.pbf";
+    OSMReader reader(osmFile);
     reader.read();
     reader.printSummary();
 
@@ -47,6 +51,28 @@ int main(int argc, char** argv){
     builder.printSummary();
     const RoadGraph& graph = builder.getGraph();
 
+    // 3. Hiérarchie de contraction : construite une fois, puis relue à côté des données OSM
+    const std::string chFile = ContractionHierarchy::defaultPath(osmFile);
+    ContractionHierarchy ch;
+    if (!ch.load(chFile, graph)) {
+        std::cout << "Construction de la hiérarchie de contraction..." << std::endl;
+        ch.build(graph);
+        ch.save(chFile);
+    }
+    ch.printSummary();
+
+    // Mode balayage de paramètres, sans interface : v2v --sweep [resultats.csv]
+    if (argc > 1 && std::string(argv[1]) == "--sweep") {
+        RoutePlanner sweepPlanner(graph);
+        sweepPlanner.setContractionHierarchy(&ch);
+
+        ParameterSweep sweep(graph, &sweepPlanner);
+        sweep.addGrid(SweepPoint(), {250.0, 500.0, 1000.0, 2000.0}, {100, 500, 1000}, {8.0, 14.0});
+
+        const std::string csvFile = argc > 2 ? argv[2] : "sweep_results.csv";
+        return ParameterSweep::writeCsv(csvFile, sweep.run()) ? 0 : 1;
+    }
+
 
     // Create main window
     // ----------------------
@@ -65,12 +91,16 @@ int main(int argc, char** argv){
     win.resize(1200, 800);
     win.show();
 
+    // --- Itinéraires partagés (A* + cache commun à tous les véhicules) ---
+    RoutePlanner planner(graph);
+    planner.setContractionHierarchy(&ch);
+
     // --- Create simulator ---
-    Simulator simulator(const_cast<RoadGraph&>(graph), map);
-    map->setSimulator(&simulator);
-    QObject::connect(&simulator, &Simulator::ticked, map, [map](double){
-        map->update();
-    });
+    Simulator simulator(graph, map);
+    map->setSimulator(&simulator);   // le rendu interpole entre deux ticks
+    map->setRenderIntervalMs(16);     // ~60 FPS, indépendant du pas de simulation
+    simulator.setRoutePlanner(&planner);
+    simulator.setSeed(1);             // runs reproductibles (voir saveCheckpoint / loadCheckpoint)
 
 
     //GENERATE RANDOM CARS
@@ -106,7 +136,7 @@ int main(int argc, char** argv){
 
     }
 
-    simulator.start(1000); // 20 FPS
+    simulator.start(1000); // 1 tick/s, le mouvement reste fluide grâce à l'interpolation
 
         return app.exec();
 }
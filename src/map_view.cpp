@@ -4,6 +4,9 @@
 #include <QMouseEvent>
 #include <QKeyEvent>
 #include <QResizeEvent>
+#include <QImage>
+#include <QSet>
+#include <QVector>
 #include <QFileInfo>
 #include <QUrl>
 #include <QNetworkRequest>
@@ -13,6 +16,7 @@
 #include <cmath>
 
 #include "simulator.h"
+#include "trace_replay.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -22,7 +26,7 @@ static inline double deg2rad(double d){ return d * M_PI / 180.0; }
 static inline double rad2deg(double r){ return r * 180.0 / M_PI; }
 
 MapView::MapView(QWidget* parent)
-    : QWidget(parent), m_memCache(1024) {
+    : QWidget(parent), m_memCache(kDefaultTileCacheBytes) {
     setFocusPolicy(Qt::StrongFocus);
     setMouseTracking(true);
     setAutoFillBackground(true);
@@ -33,6 +37,11 @@ MapView::MapView(QWidget* parent)
     connect(&m_net, &QNetworkAccessManager::finished, this, [this](QNetworkReply* rep){
         rep->deleteLater();
     });
+
+    // Rendu à la fréquence d'affichage, indépendamment du pas de simulation
+    m_frameClock.start();
+    connect(&m_renderTimer, &QTimer::timeout, this, &MapView::onRenderTimer);
+    m_renderTimer.start(kDefaultRenderIntervalMs);
 }
 
 bool MapView::loadImage(const QString& path){
@@ -45,8 +54,132 @@ bool MapView::loadImage(const QString& path){
     return true;
 }
 
+void MapView::detachSource(){
+    if(m_simulator) disconnect(m_simulator, nullptr, this, nullptr);
+    if(m_replay) disconnect(m_replay, nullptr, this, nullptr);
+    m_simulator = nullptr;
+    m_replay = nullptr;
+    m_source = nullptr;
+    m_prevSnap.reset();
+    m_currSnap.reset();
+}
+
+void MapView::setSimulator(Simulator* sim){
+    detachSource();
+    m_simulator = sim;
+    m_source = sim;
+    m_roadLayer.setGraph(sim ? &sim->getGraph() : nullptr);
+
+    if(sim){
+        connect(sim, &Simulator::ticked, this, &MapView::onSimulationTicked);
+        onSimulationTicked();
+    }
+    update();
+}
+
+void MapView::setReplay(TraceReplay* replay){
+    // Le réseau routier affiché reste celui du dernier simulateur
+    detachSource();
+    m_replay = replay;
+    m_source = replay;
+
+    if(replay){
+        connect(replay, &TraceReplay::ticked, this, &MapView::onSimulationTicked);
+        onSimulationTicked();
+    }
+    update();
+}
+
+void MapView::setRenderIntervalMs(int ms){
+    m_renderTimer.start(std::max(ms, 1));
+}
+
+void MapView::onSimulationTicked(){
+    if(!m_source) return;
+    auto snap = m_source->snapshot();
+    // Même photo que la précédente ; le numéro de tick ne suffit pas (checkpoint restauré au même tick).
+    // m_currSnap la retient : son tampon ne peut pas être recyclé pour une nouvelle photo
+    if(!snap || snap == m_currSnap) return;
+
+    const qint64 now = m_frameClock.elapsed();
+
+    // La photo courante devient la précédente ; la période mesurée sert à interpoler.
+    // Retour en arrière (relecture, checkpoint restauré) : pas d'interpolation
+    const bool forward = m_currSnap && snap->tick > m_currSnap->tick;
+    m_prevSnap = forward ? m_currSnap : snap;
+    m_tickPeriodMs = forward ? std::max<qint64>(1, now - m_currArrivalMs) : 0;
+    m_currSnap = std::move(snap);
+    m_currArrivalMs = now;
+
+    m_prevIndex.clear();
+    m_prevIndex.reserve(int(m_prevSnap->vehicles.size()));
+    for(int i=0; i<int(m_prevSnap->vehicles.size()); ++i)
+        m_prevIndex.insert(m_prevSnap->vehicles[i].id, i);
+
+    update();
+}
+
+double MapView::interpolationFactor() const{
+    if(m_tickPeriodMs <= 0) return 1.0;
+    const double t = double(m_frameClock.elapsed() - m_currArrivalMs) / double(m_tickPeriodMs);
+    return std::clamp(t, 0.0, 1.0);
+}
+
+void MapView::onRenderTimer(){
+    onSimulationTicked();
+
+    // Rien ne bouge entre deux ticks une fois l'interpolation terminée
+    if(m_currSnap && m_lastPaintAlpha < 1.0) update();
+}
+
+void MapView::updateFrame(){
+    // m_frame suit l'ordre de m_currSnap->vehicles : les liens de la photo y sont des indices
+    m_frame.clear();
+    if(!m_currSnap) return;
+
+    const double alpha = interpolationFactor();
+    m_lastPaintAlpha = alpha;
+
+    const auto& curr = m_currSnap->vehicles;
+    const auto& prev = m_prevSnap->vehicles;
+    m_frame.reserve(curr.size());
+
+    for(size_t i=0; i<curr.size(); ++i){
+        const VehicleState& c = curr[i];
+        double lat = c.lat;
+        double lon = c.lon;
+
+        // Même ordre d'un tick à l'autre dans le cas courant ; sinon recherche par id
+        const VehicleState* pv = nullptr;
+        if(i < prev.size() && prev[i].id == c.id) pv = &prev[i];
+        else {
+            auto it = m_prevIndex.constFind(c.id);
+            if(it != m_prevIndex.constEnd()) pv = &prev[*it];
+        }
+        if(pv){
+            lat = pv->lat + alpha * (c.lat - pv->lat);
+            lon = pv->lon + alpha * (c.lon - pv->lon);
+        }
+
+        m_frame.push_back({c.id, lonLatToScreen(lon, lat), lat, c.range});
+    }
+}
+
+void MapView::setShowRoadNetwork(bool show){
+    m_showRoadNetwork = show;
+    update();
+}
+
 void MapView::setTilesTemplate(const QString& pattern){
+    if(pattern == m_tilesTemplate) return;
     m_tilesTemplate = pattern;
+
+    // Tuiles indexées par (z, x, y) : celles de l'ancien serveur ne doivent plus s'afficher
+    m_memCache.clear();
+    const auto pending = m_inflight.values();
+    m_inflight.clear();
+    for(const QPointer<QNetworkReply>& rep : pending)
+        if(rep) rep->abort();
     update();
 }
 
@@ -70,8 +203,10 @@ void MapView::paintEvent(QPaintEvent*){
     if(!m_tilesTemplate.isEmpty()){
         drawTiles(p);
     } else if(!m_base.isNull()){
+        p.save();
         p.translate(-m_offsetX, -m_offsetY);
         p.drawPixmap(QPointF(0,0), m_base);
+        p.restore();
     } else {
         const int step = 64;
         QPen grid(QColor(80,80,80));
@@ -83,193 +218,183 @@ void MapView::paintEvent(QPaintEvent*){
     }
 
 
+    // Réseau routier : calque statique rastérisé une fois par tuile et par zoom
+    if(m_showRoadNetwork){
+        m_roadLayer.draw(p, m_zoom, m_offsetX, m_offsetY, size());
+    }
+
     // ----------- DEBUG --------
-    // draw edges (ways) on map to see which are detected
     QPen pen(Qt::red, 10);
     p.setPen(pen);
     p.drawPoint(width()/2, height()/2);
 
-    const auto& graph = m_simulator->getGraph();
-    int drawn = 0;
-    /*/ Draw edges first
-    for (auto ep = boost::edges(graph); ep.first != ep.second; ++ep.first) {
-        Edge e = *ep.first;
-        Vertex s = boost::source(e, graph);
-        Vertex t = boost::target(e, graph);
-
-        // récupère les coordonnées lat/lon
-        double lat1 = graph[s].lat;
-        double lon1 = graph[s].lon;
-        double lat2 = graph[t].lat;
-        double lon2 = graph[t].lon;
-
-        // convertit en pixels
-        QPointF p1 = lonLatToScreen(lon1, lat1);
-        QPointF p2 = lonLatToScreen(lon2, lat2);
-
-        // couleur et épaisseur selon type de route
-        QColor color;
-        int width = 3; // default thickness
-        const std::string& type = graph[e].type;
-
-
-        if (type == "motorway" || type == "motorway_link")  {
-            drawn ++;
-            color = QColor(255, 0, 0);  // bright red
-            width = 4;
-        } else if (type == "trunk" || type == "trunk_link") {
-            drawn ++;
-            color = QColor(255, 128, 0); // orange
-            width = 3;
-        } else if (type == "primary" || type == "primary_link") {
-            drawn ++;
-            color = QColor(255, 255, 0); // yellow
-            width = 3;
-        } else if (type == "secondary" || type == "secondary_link") {
-            drawn ++;
-            color = QColor(0, 0, 255);   // blue
-            width = 2;
-        } else if (type == "tertiary" ) {
-            drawn ++;
-            color = QColor(0, 255, 0);   // green
-            width = 1;
-        } else { color = QColor(128, 128, 128); // gray for footway, unknown, etc.
-            width = 1; }
-
-        QPen pen(color, width*2 ,  Qt::SolidLine);
-        pen.setCapStyle(Qt::RoundCap); // nicer line endings
-        p.setPen(pen);
-
-        p.drawLine(p1, p2);
 
+    //Draw vehicules on map
+    if (m_source) {
+        // Positions interpolées entre les deux dernières photos de la simulation
+        updateFrame();
+
+        // Flotte trop dense ou zoom trop faible : carte de densité agrégée
+        if (useHeatmap()) drawHeatmap(p);
+        else drawVehicles(p);
     }
 
-    // Draw nodes on top
-    int drawnNodes = 0;
-    QBrush nodeBrush(Qt::red);
-    p.setBrush(nodeBrush);
-    p.setPen(Qt::NoPen);
+    drawHUD(p);
+}
 
-    for (auto vp = boost::vertices(graph); vp.first != vp.second; ++vp.first) {
-        Vertex v = *vp.first;
-        QPointF pos = lonLatToScreen(graph[v].lat, graph[v].lon);
+bool MapView::useHeatmap() const{
+    switch(m_renderMode){
+        case RenderMode::Vehicles: return false;
+        case RenderMode::Heatmap:  return true;
+        case RenderMode::Auto:     break;
+    }
+    if(m_zoom <= m_heatmapMaxZoom) return true;
 
-        // draw small red square centered on node
-        drawnNodes ++;
-        int size = std::max(4.0, 8.0 / (1 << m_zoom));
-        QRectF rect(pos.x() - size / 2, pos.y() - size / 2, size, size);
-        p.drawRect(rect);
+    int visible = 0;
+    const QRectF view(rect());
+    for(const auto& fv : m_frame){
+        if(view.contains(fv.pt) && ++visible > m_heatmapVehicleThreshold) return true;
     }
-    */
+    return false;
+}
 
+void MapView::setRenderMode(RenderMode mode){
+    m_renderMode = mode;
+    update();
+}
 
-    //Draw vehicules on map
-    if (m_simulator) {
-        const auto& vehicles = m_simulator->vehicles();
-        const auto& interfGraph = m_simulator->interferenceGraph();
-
-        // Dessiner d'abord les rayons de transmission (cercles jaunes)
-        for (auto* v : vehicles) {
-            if (!v) continue;
-            
-            auto [lat, lon] = v->getPosition();
-            QPointF pt = lonLatToScreen(lon, lat);
-            
-            // Calculer le rayon en pixels
-            double range = v->getTransmissionRange(); // en mètres
-            double mpp = metersPerPixelAtLat(lat);
-            double radiusPixels = range / mpp;
-            
-            // Dessiner un cercle semi-transparent pour le rayon
-            QPen rangePen(QColor(255, 255, 0, 255)); // Jaune semi-transparent
-            rangePen.setWidth(3); // Épaisseur augmentée à 3 pixels
-            p.setPen(rangePen);
-            p.setBrush(Qt::NoBrush);
-            p.drawEllipse(pt, radiusPixels, radiusPixels);
-        }
+void MapView::setHeatmapThresholds(int vehicleCount, int maxZoom){
+    m_heatmapVehicleThreshold = std::max(vehicleCount, 0);
+    m_heatmapMaxZoom = maxZoom;
+    update();
+}
+
+void MapView::setHeatmapQuantity(HeatmapQuantity q){
+    m_heatmapQuantity = q;
+    update();
+}
 
-        // Dessiner d'abord les connexions transitives (lignes bleues pointillées)
-        QPen transitivePen(QColor(0, 150, 255, 255)); // Bleu semi-transparent
-        transitivePen.setWidth(2);
-        transitivePen.setStyle(Qt::DashLine); // Ligne pointillée
-        p.setPen(transitivePen);
-
-        for (auto* v : vehicles) {
-            if (!v) continue;
-            
-            auto directNeighbors = interfGraph.getDirectNeighbors(v->getId());
-            auto allReachable = interfGraph.getReachableVehicles(v->getId());
-            auto [lat1, lon1] = v->getPosition();
-            QPointF pt1 = lonLatToScreen(lon1, lat1);
-
-            // Dessiner les connexions transitives (accessibles mais pas directs)
-            for (int reachableId : allReachable) {
-                // Si c'est un voisin direct, on le saute (sera dessiné après)
-                if (directNeighbors.find(reachableId) != directNeighbors.end()) {
-                    continue;
-                }
-                
-                // Trouver le véhicule accessible
-                for (auto* reachable : vehicles) {
-                    if (reachable && reachable->getId() == reachableId) {
-                        auto [lat2, lon2] = reachable->getPosition();
-                        QPointF pt2 = lonLatToScreen(lon2, lat2);
-                        
-                        // Ne dessiner la ligne qu'une seule fois
-                        if (v->getId() < reachableId) {
-                            p.drawLine(pt1, pt2);
-                        }
-                        break;
-                    }
-                }
+void MapView::drawVehicles(QPainter& p){
+    if (!m_currSnap) return;
+
+    // Dessiner d'abord les rayons de transmission (cercles jaunes)
+    QPen rangePen(QColor(255, 255, 0, 255)); // Jaune semi-transparent
+    rangePen.setWidth(3); // Épaisseur augmentée à 3 pixels
+    p.setPen(rangePen);
+    p.setBrush(Qt::NoBrush);
+    for (const auto& fv : m_frame) {
+        // Calculer le rayon en pixels
+        double radiusPixels = fv.range / metersPerPixelAtLat(fv.lat);
+        p.drawEllipse(fv.pt, radiusPixels, radiusPixels);
+    }
+
+    // Dessiner d'abord les connexions transitives (lignes bleues pointillées)
+    QPen transitivePen(QColor(0, 150, 255, 255)); // Bleu semi-transparent
+    transitivePen.setWidth(2);
+    transitivePen.setStyle(Qt::DashLine); // Ligne pointillée
+    p.setPen(transitivePen);
+
+    // Les véhicules d'une même composante se joignent par relais ; les paires
+    // déjà reliées directement sont dessinées après
+    const auto& links = m_currSnap->links;
+    const auto& component = m_currSnap->component;
+    QSet<quint64> direct;
+    direct.reserve(int(links.size()));
+    for (const auto& [a, b] : links) direct.insert((quint64(a) << 32) | quint64(b));
+
+    QHash<int, QVector<int>> members;
+    for (int i = 0; i < int(component.size()); ++i) members[component[i]].push_back(i);
+
+    for (const auto& group : members) {
+        for (int i = 0; i < group.size(); ++i) {
+            for (int j = i + 1; j < group.size(); ++j) {
+                if (direct.contains((quint64(group[i]) << 32) | quint64(group[j]))) continue;
+                p.drawLine(m_frame[group[i]].pt, m_frame[group[j]].pt);
             }
         }
+    }
 
-        // Dessiner ensuite les connexions directes (lignes vertes épaisses)
-        QPen connectionPen(QColor(0, 255, 0, 255)); // Vert visible
-        connectionPen.setWidth(2);
-        p.setPen(connectionPen);
-
-        // Dessiner les connexions directes
-        for (auto* v : vehicles) {
-            if (!v) continue;
-            
-            auto directNeighbors = interfGraph.getDirectNeighbors(v->getId());
-            auto [lat1, lon1] = v->getPosition();
-            QPointF pt1 = lonLatToScreen(lon1, lat1);
-
-            for (int neighborId : directNeighbors) {
-                // Trouver le véhicule voisin
-                for (auto* neighbor : vehicles) {
-                    if (neighbor && neighbor->getId() == neighborId) {
-                        auto [lat2, lon2] = neighbor->getPosition();
-                        QPointF pt2 = lonLatToScreen(lon2, lat2);
-                        
-                        // Ne dessiner la ligne qu'une seule fois (éviter les doublons)
-                        if (v->getId() < neighborId) {
-                            p.drawLine(pt1, pt2);
-                        }
-                        break;
-                    }
-                }
-            }
+    // Dessiner ensuite les connexions directes (lignes vertes épaisses)
+    QPen connectionPen(QColor(0, 255, 0, 255)); // Vert visible
+    connectionPen.setWidth(2);
+    p.setPen(connectionPen);
+
+    for (const auto& [a, b] : links) {
+        p.drawLine(m_frame[a].pt, m_frame[b].pt);
+    }
+
+    // Dessiner les véhicules (points rouges) par-dessus tout
+    p.setBrush(QBrush(Qt::red));
+    p.setPen(QPen(Qt::darkRed, 2));
+    for (const auto& fv : m_frame) {
+        p.drawEllipse(fv.pt, 6, 6);  // Point rouge pour le véhicule
+    }
+}
+
+void MapView::drawHeatmap(QPainter& p){
+    if(!m_currSnap) return;
+    const int cell = kHeatmapCellPx;
+    const int gw = (width()  + cell - 1) / cell;
+    const int gh = (height() + cell - 1) / cell;
+    if(gw <= 0 || gh <= 0) return;
+
+    // Agrégation dans une grille écran : O(véhicules) puis O(cellules) pour le dessin
+    m_heatCounts.assign(size_t(gw) * gh, 0.0f);
+    auto addAt = [&](const QPointF& pt){
+        const int cx = int(std::floor(pt.x() / cell));
+        const int cy = int(std::floor(pt.y() / cell));
+        if(cx < 0 || cy < 0 || cx >= gw || cy >= gh) return;
+        m_heatCounts[size_t(cy) * gw + cx] += 1.0f;
+    };
+    if(m_heatmapQuantity == HeatmapQuantity::Links){
+        // Chaque lien compte pour ses deux extrémités
+        for(const auto& [a, b] : m_currSnap->links){
+            addAt(m_frame[a].pt);
+            addAt(m_frame[b].pt);
         }
+    } else {
+        for(const auto& fv : m_frame) addAt(fv.pt);
+    }
 
-        // Dessiner les véhicules (points rouges) par-dessus tout
-        for (auto* v : vehicles) {
-            if (!v) continue;
-            
-            auto [lat, lon] = v->getPosition();
-            QPointF pt = lonLatToScreen(lon, lat);
-            
-            // Cercle rouge pour le véhicule
-            p.setBrush(QBrush(Qt::red));
-            p.setPen(QPen(Qt::darkRed, 2));
-            p.drawEllipse(pt, 6, 6);  // Point rouge pour le véhicule
+    float maxCount = 0.0f;
+    for(float c : m_heatCounts) maxCount = std::max(maxCount, c);
+    if(maxCount <= 0.0f) return;
+
+    // Palette : transparent -> bleu -> cyan -> jaune -> rouge
+    static const std::vector<QRgb> lut = [](){
+        std::vector<QRgb> t(256);
+        const QColor stops[] = { QColor(0,0,255,0), QColor(0,80,255,140), QColor(0,255,255,170),
+                                 QColor(255,255,0,200), QColor(255,0,0,230) };
+        const int nStops = 5;
+        for(int i=0; i<256; ++i){
+            const double f = i / 255.0 * (nStops - 1);
+            const int k = std::min(int(f), nStops - 2);
+            const double u = f - k;
+            const QColor& a = stops[k];
+            const QColor& b = stops[k+1];
+            auto mix = [u](int x, int y){ return int(x + u * (y - x)); };
+            t[i] = qRgba(mix(a.red(), b.red()), mix(a.green(), b.green()),
+                         mix(a.blue(), b.blue()), mix(a.alpha(), b.alpha()));
+        }
+        return t;
+    }();
+
+    // Échelle logarithmique : les zones peu denses restent visibles à côté des bouchons
+    QImage img(gw, gh, QImage::Format_ARGB32);
+    const float norm = 255.0f / std::log1p(maxCount);
+    for(int y=0; y<gh; ++y){
+        QRgb* line = reinterpret_cast<QRgb*>(img.scanLine(y));
+        const float* row = &m_heatCounts[size_t(y) * gw];
+        for(int x=0; x<gw; ++x){
+            const int idx = row[x] > 0.0f ? std::clamp(int(std::log1p(row[x]) * norm), 1, 255) : 0;
+            line[x] = lut[idx];
         }
     }
 
-    drawHUD(p);
+    p.save();
+    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    p.drawImage(QRectF(0, 0, gw * cell, gh * cell), img);
+    p.restore();
 }
 
 void MapView::zoomAt(const QPoint& screenPos, double factor){
@@ -345,23 +470,32 @@ QString MapView::buildUrl(int z,int x,int y) const{
     return u;
 }
 
+void MapView::setTileCacheBudgetBytes(qint64 bytes){
+    m_memCache.setMaxCost(std::max<qint64>(bytes, 0));
+}
+
+qint64 MapView::pixmapCost(const QPixmap& px){
+    // Taille décodée réelle (depth en bits/pixel), et non un simple compteur de tuiles
+    return qint64(px.width()) * px.height() * std::max(px.depth(), 8) / 8;
+}
+
+void MapView::insertTile(const TileKey& key, QPixmap* px){
+    m_memCache.insert(key, px, pixmapCost(*px));
+}
+
 void MapView::requestTile(int z,int x,int y){
     if(m_tilesTemplate.isEmpty()) return;
-    const QString url = buildUrl(z,x,y);
 
-    if(QPixmap* cached = m_memCache.object(url)){
-        return;
-    }
-
-    TileKey key{z,x,y};
+    const TileKey key{z,x,y};
+    if(m_memCache.contains(key)) return;
     if(m_inflight.contains(key)) return;
 
-    if(url.startsWith("file://")){
-        const QString path = QUrl(url).toLocalFile();
+    if(m_tilesTemplate.startsWith("file://")){
+        const QString path = QUrl(buildUrl(z,x,y)).toLocalFile();
         if(QFileInfo::exists(path)){
             QPixmap* px = new QPixmap();
             if(px->load(path)){
-                m_memCache.insert(url, px);
+                insertTile(key, px);
                 update();
             } else delete px;
         }
@@ -371,12 +505,17 @@ void MapView::requestTile(int z,int x,int y){
     const qint64 now  = QDateTime::currentMSecsSinceEpoch();
     const qint64 wait = m_minRequestIntervalMs - (now - m_lastRequestMs);
     if (wait > 0) {
-        QTimer::singleShot(int(wait), this, [this, z, x, y](){ requestTile(z, x, y); });
+        QTimer::singleShot(int(wait), this, [this, z, x, y](){
+            // zoom rapide : la tuile n'est plus affichée, inutile de la télécharger
+            if(z != m_zoom) return;
+            requestTile(z, x, y);
+        });
         return;
     }
     m_lastRequestMs = now;
 
-    QNetworkRequest req{ QUrl{url} };
+    // L'URL n'est construite qu'au moment d'un vrai téléchargement
+    QNetworkRequest req{ QUrl{buildUrl(z,x,y)} };
     req.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
     req.setRawHeader("Referer", m_referer.toUtf8());
     req.setRawHeader("Cache-Control", "max-age=86400");
@@ -384,13 +523,18 @@ void MapView::requestTile(int z,int x,int y){
     QNetworkReply* rep = m_net.get(req);
     m_inflight.insert(key, rep);
 
-    connect(rep, &QNetworkReply::finished, this, [this, url, key, rep](){
+    connect(rep, &QNetworkReply::finished, this, [this, key, rep, pattern = m_tilesTemplate](){
+        // Réponse d'un ancien modèle d'URL : ignorée (l'entrée de la clé peut déjà être une autre requête)
+        if(pattern != m_tilesTemplate){
+            rep->deleteLater();
+            return;
+        }
         m_inflight.remove(key);
         if(rep->error()==QNetworkReply::NoError){
             QByteArray data = rep->readAll();
             QPixmap* px = new QPixmap();
             if(px->loadFromData(data)){
-                m_memCache.insert(url, px);
+                insertTile(key, px);
                 update();
             } else delete px;
         }
@@ -417,13 +561,12 @@ void MapView::drawTiles(QPainter& p){
             int txWrap = ((tx % n) + n) % n;
             if(ty < 0 || ty >= n) continue;
 
-            const QString url = buildUrl(m_zoom, txWrap, ty);
-            QPixmap* cached = m_memCache.object(url);
+            QPixmap* cached = m_memCache.object(TileKey{m_zoom, txWrap, ty});
             const QRectF target(tx*T - m_offsetX, ty*T - m_offsetY, T, T);
 
             if(!cached){
                 requestTile(m_zoom, txWrap, ty);
-                p.fillRect(target, QColor(60,60,60));
+                drawFallbackTile(p, m_zoom, txWrap, ty, target);
             } else {
                 p.drawPixmap(target, *cached, QRectF(0,0,T,T));
             }
@@ -431,6 +574,36 @@ void MapView::drawTiles(QPainter& p){
     }
 }
 
+void MapView::drawFallbackTile(QPainter& p, int z, int x, int y, const QRectF& target){
+    const int T = 256;
+    p.fillRect(target, QColor(60,60,60));
+
+    // Ancêtre le plus proche déjà en cache : on agrandit la sous-région correspondante
+    for(int d=1; d<=kMaxFallbackDepth && z-d >= 0; ++d){
+        const int ax = x >> d;
+        const int ay = y >> d;
+        QPixmap* parent = m_memCache.object(TileKey{z-d, ax, ay});
+        if(!parent) continue;
+
+        const double sub = double(T) / (1 << d);
+        const QRectF source((x - (ax << d)) * sub, (y - (ay << d)) * sub, sub, sub);
+        p.drawPixmap(target, *parent, source);
+        break;
+    }
+
+    // Enfants (zoom arrière) : chaque tuile z+1 en cache couvre un quart de la cible
+    if(z+1 > 20) return;
+    const double half = T / 2.0;
+    for(int cy=0; cy<2; ++cy){
+        for(int cx=0; cx<2; ++cx){
+            QPixmap* child = m_memCache.object(TileKey{z+1, 2*x+cx, 2*y+cy});
+            if(!child) continue;
+            const QRectF quarter(target.x() + cx*half, target.y() + cy*half, half, half);
+            p.drawPixmap(quarter, *child, QRectF(0,0,T,T));
+        }
+    }
+}
+
 void MapView::drawHUD(QPainter& p){
     const int margin = 12;
     const int pad = 8;
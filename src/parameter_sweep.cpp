@@ -0,0 +1,160 @@
+#include "parameter_sweep.h"
+#include "simulator.h"
+#include "vehicule.h"
+#include "route_planner.h"
+
+#include <QThreadPool>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <algorithm>
+
+namespace {
+
+// Une tâche du pool : un point du balayage, résultat écrit dans sa case
+class SweepTask : public QRunnable {
+public:
+    SweepTask(const ParameterSweep& sweep, const SweepPoint& point, SweepMetrics& result)
+        : m_sweep(sweep), m_point(point), m_result(result) {}
+
+    void run() override { m_result = m_sweep.runPoint(m_point); }
+
+private:
+    const ParameterSweep& m_sweep;
+    const SweepPoint& m_point;
+    SweepMetrics& m_result;
+};
+
+std::mutex g_logMutex;
+
+} // namespace
+
+ParameterSweep::ParameterSweep(const RoadGraph& graph, RoutePlanner* planner)
+    : graph(graph), m_planner(planner)
+{
+    for (auto vp = boost::vertices(graph); vp.first != vp.second; ++vp.first) {
+        if (Vehicule::hasValidOutgoingEdge(*vp.first, graph)) m_spawnVertices.push_back(*vp.first);
+    }
+}
+
+void ParameterSweep::addGrid(const SweepPoint& base, const std::vector<double>& ranges,
+                             const std::vector<int>& vehicleCounts, const std::vector<double>& speeds) {
+    for (double range : ranges) {
+        for (int count : vehicleCounts) {
+            for (double speed : speeds) {
+                SweepPoint p = base;
+                p.transmissionRange = range;
+                p.vehicleCount = count;
+                p.speed = speed;
+                p.label = base.label + "r" + std::to_string(int(range)) + "_n" + std::to_string(count) +
+                          "_v" + std::to_string(int(speed));
+                m_points.push_back(p);
+            }
+        }
+    }
+}
+
+std::vector<SweepMetrics> ParameterSweep::run(int maxThreads) const {
+    std::vector<SweepMetrics> results(m_points.size());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(maxThreads > 0 ? maxThreads : QThread::idealThreadCount());
+    for (size_t i = 0; i < m_points.size(); ++i) {
+        pool.start(new SweepTask(*this, m_points[i], results[i]));   // supprimée par le pool
+    }
+    pool.waitForDone();
+    return results;
+}
+
+SweepMetrics ParameterSweep::runPoint(const SweepPoint& point) const {
+    SweepMetrics m;
+    m.point = point;
+    if (m_spawnVertices.empty() || point.timeStep <= 0.0) return m;
+
+    QElapsedTimer wall;
+    wall.start();
+
+    // Simulation sans thread ni rendu : pilotée au pas fixe depuis ce thread du pool
+    Simulator sim(graph, nullptr, nullptr, Simulator::ThreadMode::Caller);
+    sim.setSeed(point.seed);
+    sim.setCarFollowingEnabled(point.carFollowing);
+    if (point.goalDirected) sim.setRoutePlanner(m_planner);
+
+    std::mt19937 spawn(point.seed);
+    std::uniform_int_distribution<size_t> pick(0, m_spawnVertices.size() - 1);
+    for (int i = 0; i < point.vehicleCount; ++i) {
+        const Vertex start = m_spawnVertices[pick(spawn)];
+        const Vertex goal = m_spawnVertices[pick(spawn)];
+        sim.addVehicle(new Vehicule(i, graph, start, goal, point.speed, point.transmissionRange, point.collisionDist));
+    }
+    sim.setEventDrivenEnabled(point.eventDriven);
+
+    while (sim.simulationTime() + 1e-9 < point.duration) {
+        sim.advance(point.timeStep);
+        if (sim.simulationTime() < point.warmup) continue;
+
+        const InterferenceGraph::GenerationPtr gen = sim.interferenceGraph().snapshot();
+        const int n = gen->vehicleCount();
+        if (n == 0) continue;
+
+        int isolated = 0;
+        for (int i = 0; i < n; ++i) isolated += gen->degree(i) == 0;
+        int largest = 0;
+        for (int c = 0; c < gen->componentCount(); ++c) largest = std::max(largest, gen->componentSize(c));
+        double speed = 0.0;
+        for (const Vehicule* v : sim.vehicles()) speed += v ? v->getSpeed() : 0.0;
+
+        ++m.samples;
+        m.meanLinks += gen->linkCount();
+        m.meanDegree += 2.0 * gen->linkCount() / n;
+        m.meanIsolated += double(isolated) / n;
+        m.meanComponents += gen->componentCount();
+        m.meanLargestComponent += double(largest) / n;
+        m.meanSpeed += speed / n;
+    }
+
+    if (m.samples > 0) {
+        const double k = 1.0 / m.samples;
+        m.meanLinks *= k;
+        m.meanDegree *= k;
+        m.meanIsolated *= k;
+        m.meanComponents *= k;
+        m.meanLargestComponent *= k;
+        m.meanSpeed *= k;
+    }
+    m.ticks = sim.tickCount();
+    m.simTime = sim.simulationTime();
+    m.wallSeconds = wall.elapsed() / 1000.0;
+
+    {
+        std::lock_guard<std::mutex> lock(g_logMutex);
+        std::cout << "Balayage : " << point.label << " terminé en " << m.wallSeconds << " s" << std::endl;
+    }
+    return m;
+}
+
+bool ParameterSweep::writeCsv(const std::string& path, const std::vector<SweepMetrics>& results) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Erreur : impossible d'écrire " << path << std::endl;
+        return false;
+    }
+    out << "label,vehicles,speed,range,car_following,event_driven,goal_directed,seed,"
+           "ticks,sim_time,wall_seconds,samples,links,degree,isolated,components,largest_component,mean_speed\n";
+    for (const auto& m : results) {
+        const SweepPoint& p = m.point;
+        out << p.label << ',' << p.vehicleCount << ',' << p.speed << ',' << p.transmissionRange << ','
+            << p.carFollowing << ',' << p.eventDriven << ',' << p.goalDirected << ',' << p.seed << ','
+            << m.ticks << ',' << m.simTime << ',' << m.wallSeconds << ',' << m.samples << ','
+            << m.meanLinks << ',' << m.meanDegree << ',' << m.meanIsolated << ','
+            << m.meanComponents << ',' << m.meanLargestComponent << ',' << m.meanSpeed << '\n';
+    }
+    if (!out) {
+        std::cerr << "Erreur : écriture incomplète de " << path << std::endl;
+        return false;
+    }
+    return true;
+}
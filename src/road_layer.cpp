@@ -0,0 +1,202 @@
+#include "road_layer.h"
+#include "map_view.h"
+#include <QPainter>
+#include <QImage>
+#include <QPen>
+#include <algorithm>
+#include <cmath>
+
+RoadLayer::RoadLayer() : m_cache(kDefaultCacheBytes) {}
+
+void RoadLayer::setGraph(const RoadGraph* graph) {
+    m_graph = graph;
+    buildIndex();
+}
+
+void RoadLayer::invalidate() {
+    buildIndex();
+}
+
+void RoadLayer::setCacheBudgetBytes(qint64 bytes) {
+    m_cache.setMaxCost(std::max<qint64>(bytes, 0));
+}
+
+bool RoadLayer::classify(const std::string& type, RoadClass& cls) {
+    if (type == "motorway" || type == "motorway_link")            cls = Motorway;
+    else if (type == "trunk" || type == "trunk_link")             cls = Trunk;
+    else if (type == "primary" || type == "primary_link")         cls = Primary;
+    else if (type == "secondary" || type == "secondary_link")     cls = Secondary;
+    else if (type == "tertiary")                                  cls = Tertiary;
+    else if (type == "unknown")                                   return false; // pas une route (bâtiments, etc.)
+    else                                                          cls = Minor;
+    return true;
+}
+
+void RoadLayer::buildIndex() {
+    m_cache.clear();
+    m_segments.clear();
+    m_cells.clear();
+    if (!m_graph) return;
+
+    const RoadGraph& graph = *m_graph;
+
+    // Projection de chaque sommet une seule fois (zoom 0)
+    std::vector<double> wx(boost::num_vertices(graph)), wy(boost::num_vertices(graph));
+    for (auto vp = boost::vertices(graph); vp.first != vp.second; ++vp.first) {
+        Vertex v = *vp.first;
+        MapView::lonlatToPixel(graph[v].lon, graph[v].lat, 0, wx[v], wy[v]);
+    }
+
+    for (auto ep = boost::edges(graph); ep.first != ep.second; ++ep.first) {
+        Edge e = *ep.first;
+        RoadClass cls;
+        if (!classify(graph[e].type, cls)) continue;
+        Vertex s = boost::source(e, graph);
+        Vertex t = boost::target(e, graph);
+        m_segments.push_back({wx[s], wy[s], wx[t], wy[t], cls});
+    }
+
+    // Ordre de dessin : petites routes d'abord, autoroutes par-dessus
+    std::stable_sort(m_segments.begin(), m_segments.end(),
+                     [](const Segment& a, const Segment& b){ return a.cls < b.cls; });
+
+    // Indexation : chaque segment va dans toutes les cellules couvertes par sa boîte englobante
+    const double scale = double(1 << kIndexZoom) / 256.0;
+    for (uint32_t i = 0; i < m_segments.size(); ++i) {
+        const Segment& s = m_segments[i];
+        int cx0 = int(std::floor(std::min(s.ax, s.bx) * scale));
+        int cx1 = int(std::floor(std::max(s.ax, s.bx) * scale));
+        int cy0 = int(std::floor(std::min(s.ay, s.by) * scale));
+        int cy1 = int(std::floor(std::max(s.ay, s.by) * scale));
+        for (int cy = cy0; cy <= cy1; ++cy)
+            for (int cx = cx0; cx <= cx1; ++cx)
+                m_cells[cellKey(cx, cy)].push_back(i);
+    }
+
+    m_stamp.assign(m_segments.size(), 0);
+    m_stampGen = 0;
+}
+
+void RoadLayer::collectSegments(const TileKey& key, std::vector<uint32_t>& out) {
+    out.clear();
+    if (m_cells.empty()) return;
+
+    if (++m_stampGen == 0) {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_stampGen = 1;
+    }
+
+    // Emprise de la tuile (avec marge) convertie en cellules de la grille d'index
+    const double toIndex = std::pow(2.0, kIndexZoom - key.z) / 256.0;
+    const int cx0 = int(std::floor((key.x * 256.0 - kTileMarginPx) * toIndex));
+    const int cx1 = int(std::floor(((key.x + 1) * 256.0 + kTileMarginPx) * toIndex));
+    const int cy0 = int(std::floor((key.y * 256.0 - kTileMarginPx) * toIndex));
+    const int cy1 = int(std::floor(((key.y + 1) * 256.0 + kTileMarginPx) * toIndex));
+
+    auto take = [&](const std::vector<uint32_t>& ids) {
+        for (uint32_t id : ids) {
+            if (m_stamp[id] == m_stampGen) continue;
+            m_stamp[id] = m_stampGen;
+            out.push_back(id);
+        }
+    };
+
+    // Zoom faible : la tuile couvre plus de cellules qu'il n'en existe, on parcourt l'index
+    const double rangeCells = double(cx1 - cx0 + 1) * double(cy1 - cy0 + 1);
+    if (rangeCells > double(m_cells.size())) {
+        for (const auto& [k, ids] : m_cells) {
+            const int cx = int(uint32_t(k >> 32));
+            const int cy = int(uint32_t(k));
+            if (cx < cx0 || cx > cx1 || cy < cy0 || cy > cy1) continue;
+            take(ids);
+        }
+    } else {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                auto it = m_cells.find(cellKey(cx, cy));
+                if (it != m_cells.end()) take(it->second);
+            }
+        }
+    }
+
+    // Les indices suivent l'ordre des classes : on rétablit l'ordre de dessin
+    std::sort(out.begin(), out.end());
+}
+
+QPixmap RoadLayer::renderTile(const TileKey& key) {
+    collectSegments(key, m_scratch);
+    if (m_scratch.empty()) return QPixmap();
+
+    // Couleur et épaisseur selon le type de route
+    static const QColor colors[RoadClassCount] = {
+        QColor(128, 128, 128),  // gris : petites routes, chemins, etc.
+        QColor(0, 255, 0),      // vert : tertiary
+        QColor(0, 0, 255),      // bleu : secondary
+        QColor(255, 255, 0),    // jaune : primary
+        QColor(255, 128, 0),    // orange : trunk
+        QColor(255, 0, 0)       // rouge : motorway
+    };
+    static const int widths[RoadClassCount] = {1, 1, 2, 3, 3, 4};
+
+    QImage img(256, 256, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+
+    QPainter p(&img);
+    p.setRenderHint(QPainter::Antialiasing, true);
+
+    const double scale = std::pow(2.0, key.z);
+    const double ox = key.x * 256.0;
+    const double oy = key.y * 256.0;
+    int currentCls = -1;
+    int drawn = 0;
+
+    for (uint32_t id : m_scratch) {
+        const Segment& s = m_segments[id];
+        if (s.cls == Minor && key.z < kMinorRoadsMinZoom) continue;
+
+        if (s.cls != currentCls) {
+            currentCls = s.cls;
+            QPen pen(colors[s.cls], widths[s.cls] * 2, Qt::SolidLine);
+            pen.setCapStyle(Qt::RoundCap);
+            p.setPen(pen);
+        }
+        p.drawLine(QPointF(s.ax * scale - ox, s.ay * scale - oy),
+                   QPointF(s.bx * scale - ox, s.by * scale - oy));
+        ++drawn;
+    }
+    p.end();
+
+    if (drawn == 0) return QPixmap();
+    return QPixmap::fromImage(img);
+}
+
+const QPixmap* RoadLayer::tile(const TileKey& key) {
+    if (QPixmap* cached = m_cache.object(key)) return cached;
+
+    // Les tuiles vides sont aussi mises en cache (pixmap nulle, coût 1)
+    QPixmap* px = new QPixmap(renderTile(key));
+    const qint64 cost = px->isNull() ? 1 : qint64(px->width()) * px->height() * std::max(px->depth(), 8) / 8;
+    if (!m_cache.insert(key, px, cost)) return nullptr;
+    return px;
+}
+
+void RoadLayer::draw(QPainter& p, int z, double offsetX, double offsetY, const QSize& viewport) {
+    if (m_segments.empty()) return;
+
+    const int T = 256;
+    const int n = 1 << z;
+    int x0 = int(std::floor(offsetX / T));
+    int y0 = int(std::floor(offsetY / T));
+    int x1 = int(std::floor((offsetX + viewport.width()) / T));
+    int y1 = int(std::floor((offsetY + viewport.height()) / T));
+
+    for (int ty = y0; ty <= y1; ++ty) {
+        if (ty < 0 || ty >= n) continue;
+        for (int tx = x0; tx <= x1; ++tx) {
+            int txWrap = ((tx % n) + n) % n;
+            const QPixmap* px = tile(TileKey{z, txWrap, ty});
+            if (!px || px->isNull()) continue;
+            p.drawPixmap(QPointF(tx*T - offsetX, ty*T - offsetY), *px);
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#include "route_planner.h"
+#include "contraction_hierarchy.h"
+#include "graph_builder.h"
+#include "vehicule.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+namespace {
+
+// Espace de travail A* : tableaux marqués par génération, jamais réinitialisés en entier
+struct AStarWorkspace {
+    std::vector<double> g;        // coût depuis l'origine
+    std::vector<Vertex> parent;
+    std::vector<uint32_t> seen;   // génération de la dernière visite
+    std::vector<uint32_t> closed;
+    uint32_t generation = 0;
+
+    void prepare(size_t n) {
+        if (g.size() != n) {
+            g.assign(n, 0.0);
+            parent.assign(n, 0);
+            seen.assign(n, 0);
+            closed.assign(n, 0);
+            generation = 0;
+        }
+        if (++generation == 0) {
+            std::fill(seen.begin(), seen.end(), 0);
+            std::fill(closed.begin(), closed.end(), 0);
+            generation = 1;
+        }
+    }
+};
+
+} // namespace
+
+RoutePlanner::RoutePlanner(const RoadGraph& graph, size_t cacheCapacity)
+    : graph(graph), m_capacity(std::max<size_t>(cacheCapacity, 1)) {}
+
+RoutePlanner::Route RoutePlanner::route(Vertex origin, Vertex destination) {
+    const uint64_t k = key(origin, destination);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(k);
+        if (it != m_index.end()) {
+            ++m_hits;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            const Route& r = it->second->second;
+            return r->empty() ? nullptr : r;
+        }
+        ++m_misses;
+    }
+
+    // Recherche hors verrou : les autres threads continuent de lire le cache
+    auto path = std::make_shared<std::vector<Vertex>>();
+    if (!computeRoute(origin, destination, *path)) path->clear();
+    Route r = std::move(path);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_index.find(k) == m_index.end()) {
+            // Les destinations inaccessibles sont aussi retenues (itinéraire vide)
+            m_lru.emplace_front(k, r);
+            m_index[k] = m_lru.begin();
+            if (m_lru.size() > m_capacity) {
+                m_index.erase(m_lru.back().first);
+                m_lru.pop_back();
+            }
+        }
+    }
+    return r->empty() ? nullptr : r;
+}
+
+void RoutePlanner::setContractionHierarchy(const ContractionHierarchy* ch) {
+    m_ch = ch;
+    clearCache();
+}
+
+void RoutePlanner::clearCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lru.clear();
+    m_index.clear();
+}
+
+size_t RoutePlanner::cacheHits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t RoutePlanner::cacheMisses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+bool RoutePlanner::computeRoute(Vertex origin, Vertex destination, std::vector<Vertex>& path) const {
+    if (m_ch && m_ch->isReady()) return m_ch->route(origin, destination, path);
+    return astar(origin, destination, path);
+}
+
+bool RoutePlanner::astar(Vertex origin, Vertex destination, std::vector<Vertex>& path) const {
+    path.clear();
+    const size_t n = boost::num_vertices(graph);
+    if (origin >= n || destination >= n) return false;
+    if (origin == destination) {
+        path.push_back(origin);
+        return true;
+    }
+
+    thread_local AStarWorkspace ws;
+    ws.prepare(n);
+
+    const double goalLat = graph[destination].lat;
+    const double goalLon = graph[destination].lon;
+    auto heuristic = [&](Vertex v) {
+        return GraphBuilder::distance(graph[v].lat, graph[v].lon, goalLat, goalLon);
+    };
+
+    // File de priorité sur f = g + h (entrées périmées ignorées à la sortie)
+    using Item = std::pair<double, Vertex>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+
+    ws.g[origin] = 0.0;
+    ws.seen[origin] = ws.generation;
+    open.push({heuristic(origin), origin});
+
+    while (!open.empty()) {
+        const Vertex u = open.top().second;
+        open.pop();
+        if (ws.closed[u] == ws.generation) continue;
+        ws.closed[u] = ws.generation;
+
+        if (u == destination) {
+            for (Vertex v = destination; v != origin; v = ws.parent[v]) path.push_back(v);
+            path.push_back(origin);
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        auto [itStart, itEnd] = boost::out_edges(u, graph);
+        for (auto it = itStart; it != itEnd; ++it) {
+            const Edge e = *it;
+            if (!Vehicule::isValidRoad(graph[e].type)) continue;
+
+            const Vertex v = boost::target(e, graph);
+            if (ws.closed[v] == ws.generation) continue;
+
+            const double g = ws.g[u] + graph[e].distance;
+            if (ws.seen[v] != ws.generation || g < ws.g[v]) {
+                ws.seen[v] = ws.generation;
+                ws.g[v] = g;
+                ws.parent[v] = u;
+                open.push({g + heuristic(v), v});
+            }
+        }
+    }
+    return false;
+}
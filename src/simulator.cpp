@@ -3,71 +3,603 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <fstream>
+#include <sstream>
 
-Simulator::Simulator(RoadGraph& graph, MapView* mapView, QObject* parent)
+#include "binary_io.h"
+#include "kinetic_links.h"
+
+namespace {
+
+constexpr char kCheckpointMagic[8] = {'V', '2', 'V', 'C', 'K', 'P', 'T', 0};
+constexpr uint32_t kCheckpointVersion = 2;
+
+// Bornes de lecture : un fichier corrompu ne doit pas provoquer d'allocation démesurée
+constexpr uint64_t kMaxCheckpointVehicles = 10000000;
+constexpr uint64_t kMaxRouteLength = 10000000;
+constexpr uint64_t kMaxRngStateBytes = 1 << 16;
+
+struct ArrivalRecord {
+    double time;
+    int32_t vehicle;
+};
+
+enum CheckpointFlags : uint8_t {
+    kFlagCollision = 1,
+    kFlagCarFollowing = 2,
+    kFlagEventDriven = 4,
+    kFlagDirectedLinks = 8,
+    kFlagChangeTracking = 16,
+    kFlagKineticLinks = 32,
+};
+
+void writeVehicleState(std::ostream& out, const Vehicule::State& v) {
+    writePod(out, int32_t(v.id));
+    writePod(out, v.start);
+    writePod(out, v.goal);
+    writePod(out, v.currVertex);
+    writePod(out, v.nextVertex);
+    writePod(out, v.previousVertex);
+    writePod(out, v.plannedNext);
+    writePod(out, v.speed);
+    writePod(out, v.desiredSpeed);
+    writePod(out, v.transmissionRange);
+    writePod(out, v.collisionDist);
+    writePod(out, v.positionOnEdge);
+    writePod(out, v.edgeLength);
+    writePod(out, v.edgeEntryTime);
+    writePod(out, uint8_t((v.hasPlannedNext ? 1 : 0) | (v.destReached ? 2 : 0) | (v.followsRoute ? 4 : 0)));
+    writeVector(out, v.route);
+}
+
+bool readVehicleState(std::istream& in, Vehicule::State& v) {
+    int32_t id = 0;
+    uint8_t bits = 0;
+    bool ok = readPod(in, id) && readPod(in, v.start) && readPod(in, v.goal) &&
+              readPod(in, v.currVertex) && readPod(in, v.nextVertex) &&
+              readPod(in, v.previousVertex) && readPod(in, v.plannedNext) &&
+              readPod(in, v.speed) && readPod(in, v.desiredSpeed) &&
+              readPod(in, v.transmissionRange) && readPod(in, v.collisionDist) &&
+              readPod(in, v.positionOnEdge) && readPod(in, v.edgeLength) &&
+              readPod(in, v.edgeEntryTime) && readPod(in, bits) &&
+              readVector(in, v.route, kMaxRouteLength);
+    v.id = id;
+    v.hasPlannedNext = bits & 1;
+    v.destReached = bits & 2;
+    v.followsRoute = bits & 4;
+    return ok;
+}
+
+} // namespace
+
+Simulator::Simulator(const RoadGraph& graph, MapView* mapView, QObject* parent, ThreadMode mode)
     :graph(graph), m_mapView(mapView), QObject(parent)
 {
     // initialize elapsed timer
     m_elapsed.start();
 
-    // setup the QTimer
-    m_timer = new QTimer(this);
-    connect(m_timer, &QTimer::timeout, this, &Simulator::onTick);
+    // setup the QTimer: it lives in the simulation thread, so onTick never runs on the GUI thread
+    m_timer = new QTimer();
+    connect(m_timer, &QTimer::timeout, m_timer, [this]() { onTick(); });
+
+    if (mode == ThreadMode::Dedicated) {
+        m_timer->moveToThread(&m_thread);
+        m_thread.setObjectName("simulation");
+        m_thread.start();
+    }
 }
 
 Simulator::~Simulator() {
-    stop();
+    if (m_thread.isRunning()) {
+        // stop the timer from its own thread, then join the thread before deleting it
+        QMetaObject::invokeMethod(m_timer, [this]() { m_timer->stop(); }, Qt::BlockingQueuedConnection);
+        m_thread.quit();
+        m_thread.wait();
+    }
+    delete m_timer;
+
+    for (Vehicule* v : m_vehicles) delete v;  // addVehicle takes ownership
+}
+
+template <typename F>
+void Simulator::runInSimulationThread(F&& f) {
+    if (!m_thread.isRunning()) {
+        f();  // ThreadMode::Caller
+        return;
+    }
+    // queued calls are executed in order, between two ticks
+    QMetaObject::invokeMethod(m_timer, std::forward<F>(f), Qt::QueuedConnection);
+}
+
+template <typename F>
+void Simulator::runInSimulationThreadAndWait(F&& f) {
+    if (!m_thread.isRunning() || QThread::currentThread() == &m_thread) {
+        f();
+        return;
+    }
+    QMetaObject::invokeMethod(m_timer, std::forward<F>(f), Qt::BlockingQueuedConnection);
 }
 
 void Simulator::start(int tickIntervalMs) {
-    m_tickIntervalMs = tickIntervalMs;
-    m_elapsed.restart();
-    m_timer->start(tickIntervalMs);
+    runInSimulationThread([this, tickIntervalMs]() {
+        m_tickIntervalMs = tickIntervalMs;
+        publishSnapshot(); // positions initiales visibles avant le premier tick
+        m_elapsed.restart();
+        m_timer->start(tickIntervalMs);
+    });
     emit simulationStarted();
 }
 
 void Simulator::pause() {
-    m_timer->stop();
+    runInSimulationThread([this]() { m_timer->stop(); });
     emit simulationPaused();
 }
 
 void Simulator::resume() {
-    m_elapsed.restart();
-    m_timer->start(m_tickIntervalMs);
+    runInSimulationThread([this]() {
+        m_elapsed.restart();
+        m_timer->start(m_tickIntervalMs);
+    });
     emit simulationResumed();
 }
 
 void Simulator::stop() {
-    m_timer->stop();
+    runInSimulationThread([this]() { m_timer->stop(); });
     emit simulationStopped();
 }
 
+void Simulator::setSpeedMultiplier(double m) {
+    m_speedMultiplier.store(m);
+}
+
+double Simulator::speedMultiplier() const {
+    return m_speedMultiplier.load();
+}
+
+void Simulator::setCollisionDetectionEnabled(bool e) {
+    m_collisionDetectionEnabled.store(e);
+}
+
+void Simulator::setCarFollowingEnabled(bool e) {
+    m_carFollowingEnabled.store(e);
+}
+
+void Simulator::setIdmParams(const IdmParams& params) {
+    runInSimulationThread([this, params]() { m_idmParams = params; });
+}
+
+void Simulator::setEventDrivenEnabled(bool e) {
+    runInSimulationThread([this, e]() {
+        if (e == m_eventDriven) return;
+        m_eventDriven = e;
+        m_arrivals = {};
+
+        for (int i = 0; i < int(m_vehicles.size()); ++i) {
+            if (!m_vehicles[i]) continue;
+            // positions are anchored on m_simTime; switching back materializes them
+            m_vehicles[i]->setLazyClock(e ? &m_simTime : nullptr);
+            if (e) enterEventMode(i);
+        }
+    });
+}
+
+void Simulator::enterEventMode(int i) {
+    // car following does not run in this mode: a vehicle it had slowed down or stopped
+    // would keep that speed forever (the lazy clock was just anchored, so this is safe)
+    m_vehicles[i]->setSpeed(m_vehicles[i]->getDesiredSpeed());
+    // a vehicle waiting on a vertex picks its first edge right away
+    if (!m_vehicles[i]->isOnEdge()) m_vehicles[i]->arriveAt(m_simTime);
+    scheduleArrival(i, m_simTime);
+}
+
+void Simulator::scheduleArrival(int i, double now) {
+    Vehicule* v = m_vehicles[i];
+    double t = v->nextArrivalTime();
+    if (t == std::numeric_limits<double>::infinity()) return;  // stopped: nothing will happen
+    if (t <= now) t = now + (v->isOnEdge() ? kMinEventDelay : kStuckRetrySeconds);
+    m_arrivals.push({t, i});
+}
+
+void Simulator::advanceEvents(double deltaSeconds) {
+    const double target = m_simTime + deltaSeconds;
+
+    // Only vehicles reaching a vertex during this interval do any work
+    while (!m_arrivals.empty() && m_arrivals.top().first <= target) {
+        const auto [t, i] = m_arrivals.top();
+        m_arrivals.pop();
+        m_vehicles[i]->arriveAt(t);
+        scheduleArrival(i, t);
+    }
+    m_simTime = target;
+}
+
+void Simulator::stepOnce() {
+    runInSimulationThread([this]() {
+        updateSimulation(m_tickIntervalMs / 1000.0 * m_speedMultiplier.load());
+    });
+}
+
+void Simulator::advance(double deltaSeconds) {
+    updateSimulation(deltaSeconds);
+}
+
 void Simulator::onTick() {
     double deltaTime = m_elapsed.restart() / 1000.0; // seconds
-    deltaTime *= m_speedMultiplier;
+    deltaTime *= m_speedMultiplier.load();
+    updateSimulation(deltaTime);
+}
 
-    // Mise à jour de la position des véhicules
-    for (Vehicule* v : m_vehicles) {
-        if(v) v->update(deltaTime);
+void Simulator::updateSimulation(double deltaTime) {
+    if (m_eventDriven) {
+        // Mode événementiel : seuls les changements d'arête sont traités
+        advanceEvents(deltaTime);
+    } else {
+        // Vitesses : modèle de poursuite (IDM) à partir de l'occupation du tick précédent
+        const bool carFollowing = m_carFollowingEnabled.load();
+        if (carFollowing) applyCarFollowing(deltaTime);
+
+        // Mise à jour de la position des véhicules
+        for (Vehicule* v : m_vehicles) {
+            if(v) v->update(deltaTime);
+        }
+        m_simTime += deltaTime;
+
+        // Occupation des arêtes (incrémentale), puis anti-collision sur le véhicule de tête
+        m_occupancy.update(m_vehicles);
+        if (!carFollowing && m_collisionDetectionEnabled.load()) {
+            for (int i = 0; i < int(m_vehicles.size()); ++i) {
+                if (m_vehicles[i]) m_vehicles[i]->avoidCollision(m_occupancy.gapToLeader(i, m_vehicles));
+            }
+        }
     }
 
     // Reconstruction du graphe d'interférence avec les nouvelles positions
     m_interferenceGraph.buildGraph(m_vehicles);
 
+    // Couche radio : les trames du tick circulent sur la nouvelle topologie
+    if (m_mac) m_mac->advance(*m_interferenceGraph.snapshot(), deltaTime);
+
+    ++m_tick;
+    publishSnapshot();
+    if (m_trace.isOpen()) m_trace.append(*m_snapshot);
+
     emit ticked(deltaTime);
 }
 
+bool Simulator::findLeader(int i, double& gap, double& leaderSpeed) {
+    Vehicule* v = m_vehicles[i];
+    if (!v->isOnEdge()) return false;
+
+    // Same edge: O(1) from the occupancy index
+    const int leader = m_occupancy.leaderOf(i);
+    if (leader >= 0) {
+        gap = m_vehicles[leader]->getPositionOnEdge() - v->getPositionOnEdge();
+        leaderSpeed = m_vehicles[leader]->getSpeed();
+        return true;
+    }
+
+    // Next edge: the rearmost vehicle on the edge the vehicle will take after this one
+    const Vertex to = v->getToVertex();
+    const Vertex after = v->peekNextVertex();
+    if (after == to) return false;
+
+    const std::vector<int>* next = m_occupancy.lane(to, after);
+    if (!next || next->empty()) return false;
+
+    const Vehicule* rear = m_vehicles[next->front()];
+    gap = (v->getEdgeLength() - v->getPositionOnEdge()) + rear->getPositionOnEdge();
+    leaderSpeed = rear->getSpeed();
+    return true;
+}
+
+void Simulator::applyCarFollowing(double deltaSeconds) {
+    const int n = int(m_vehicles.size());
+    m_idm.resize(n);
+
+    // Gather: one entry per vehicle, no leader => infinite gap (free road)
+    for (int i = 0; i < n; ++i) {
+        Vehicule* v = m_vehicles[i];
+        double gap = EdgeOccupancy::kNoGap;
+        double leaderSpeed = 0.0;
+
+        if (v && findLeader(i, gap, leaderSpeed)) {
+            gap -= m_idmParams.vehicleLength;   // bumper-to-bumper distance
+        }
+        m_idm.speed[i] = v ? v->getSpeed() : 0.0;
+        m_idm.desiredSpeed[i] = v ? v->getDesiredSpeed() : 1.0;
+        m_idm.gap[i] = gap;
+        m_idm.leaderSpeed[i] = leaderSpeed;
+    }
+
+    // Vectorized pass over the arrays
+    computeAccelerations(m_idmParams, m_idm);
+
+    // Scatter: explicit Euler on speeds, never driving backwards
+    for (int i = 0; i < n; ++i) {
+        if (m_vehicles[i]) m_vehicles[i]->setSpeed(std::max(0.0, m_idm.speed[i] + m_idm.accel[i] * deltaSeconds));
+    }
+}
+
+std::shared_ptr<SimulationSnapshot> Simulator::acquireSnapshotBuffer() {
+    // Buffers come back through the deleter once their last reader drops them; the mutex
+    // orders that reader's accesses before our reuse of the capacity
+    std::unique_ptr<SimulationSnapshot> buf;
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotPool->mutex);
+        if (!m_snapshotPool->free.empty()) {
+            buf = std::move(m_snapshotPool->free.back());
+            m_snapshotPool->free.pop_back();
+        }
+    }
+    if (!buf) buf = std::make_unique<SimulationSnapshot>();
+
+    return std::shared_ptr<SimulationSnapshot>(buf.release(), [pool = m_snapshotPool](SimulationSnapshot* snap) {
+        std::unique_ptr<SimulationSnapshot> owned(snap);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->free.size() < SnapshotPool::kMaxFree) pool->free.push_back(std::move(owned));
+    });
+}
+
+void Simulator::publishSnapshot() {
+    std::shared_ptr<SimulationSnapshot> snap = acquireSnapshotBuffer();
+    snap->tick = m_tick;
+    snap->simTime = m_simTime;
+    snap->vehicles.clear();
+    snap->links.clear();
+    snap->component.clear();
+    snap->vehicles.reserve(m_vehicles.size());
+
+    for (Vehicule* v : m_vehicles) {
+        if (!v) continue;
+        auto [lat, lon] = v->getPosition();
+        snap->vehicles.push_back({v->getId(), lat, lon, v->getTransmissionRange()});
+    }
+
+    // Liens directs et composantes tirés de la génération courante du graphe d'interférence
+    m_interferenceGraph.snapshot()->exportLinks(*snap);
+
+    std::atomic_store(&m_snapshot, std::shared_ptr<const SimulationSnapshot>(std::move(snap)));
+}
+
+void Simulator::setRoutePlanner(RoutePlanner* planner) {
+    runInSimulationThread([this, planner]() { m_routePlanner = planner; });
+}
+
+void Simulator::setMacSimulator(MacSimulator* mac) {
+    runInSimulationThread([this, mac]() { m_mac = mac; });
+}
+
+void Simulator::setPropagationModel(PropagationModel model, const RadioParams& params) {
+    runInSimulationThread([this, model, params]() { m_interferenceGraph.setPropagationModel(model, params); });
+}
+
+void Simulator::setDirectedLinksEnabled(bool e) {
+    runInSimulationThread([this, e]() { m_interferenceGraph.setDirectedLinksEnabled(e); });
+}
+
+void Simulator::setLinkChangeTrackingEnabled(bool e) {
+    runInSimulationThread([this, e]() { m_interferenceGraph.setChangeTrackingEnabled(e); });
+}
+
+void Simulator::setKineticLinksEnabled(bool e, double horizon) {
+    runInSimulationThread([this, e, horizon]() { m_interferenceGraph.setKineticLinksEnabled(e, horizon); });
+}
+
+void Simulator::setSeed(uint32_t seed) {
+    runInSimulationThread([this, seed]() { m_rng.seed(seed); });
+}
+
 void Simulator::addVehicle(Vehicule* v) {
-    if(v) m_vehicles.push_back(v);
+    if(!v) return;
+    runInSimulationThread([this, v]() {
+        v->setRandomEngine(&m_rng);
+        if (m_routePlanner) v->setRoutePlanner(m_routePlanner);
+        m_vehicles.push_back(v);
+        if (m_eventDriven) {
+            v->setLazyClock(&m_simTime);
+            enterEventMode(int(m_vehicles.size()) - 1);
+        }
+    });
+}
+
+bool Simulator::saveCheckpoint(const std::string& path) {
+    bool ok = false;
+    runInSimulationThreadAndWait([this, &path, &ok]() {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Erreur : impossible de créer le checkpoint " << path << std::endl;
+            return;
+        }
+        ok = writeCheckpoint(out);
+        if (!ok) std::cerr << "Erreur : écriture incomplète du checkpoint " << path << std::endl;
+    });
+    return ok;
+}
+
+bool Simulator::loadCheckpoint(const std::string& path) {
+    bool ok = false;
+    runInSimulationThreadAndWait([this, &path, &ok]() {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::cerr << "Erreur : impossible d'ouvrir le checkpoint " << path << std::endl;
+            return;
+        }
+        ok = readCheckpoint(in, path);
+    });
+    return ok;
 }
 
+bool Simulator::startRecording(const std::string& path, uint32_t chunkFrames) {
+    bool ok = false;
+    runInSimulationThreadAndWait([this, &path, chunkFrames, &ok]() {
+        ok = m_trace.open(path, chunkFrames, m_interferenceGraph.propagationModel(),
+                          m_interferenceGraph.radioParams());
+        if (ok && m_snapshot) ok = m_trace.append(*m_snapshot);  // état de départ
+    });
+    return ok;
+}
+
+bool Simulator::stopRecording() {
+    bool ok = false;
+    runInSimulationThreadAndWait([this, &ok]() { ok = m_trace.close(); });
+    return ok;
+}
+
+bool Simulator::writeCheckpoint(std::ostream& out) const {
+    out.write(kCheckpointMagic, sizeof(kCheckpointMagic));
+    writePod(out, kCheckpointVersion);
+    writePod(out, GraphBuilder::fingerprint(graph));
+
+    // Horloge et paramètres
+    writePod(out, m_tick);
+    writePod(out, m_simTime);
+    writePod(out, int32_t(m_tickIntervalMs));
+    writePod(out, m_speedMultiplier.load());
+    uint8_t flags = 0;
+    if (m_collisionDetectionEnabled.load()) flags |= kFlagCollision;
+    if (m_carFollowingEnabled.load()) flags |= kFlagCarFollowing;
+    if (m_eventDriven) flags |= kFlagEventDriven;
+    if (m_interferenceGraph.directedLinksEnabled()) flags |= kFlagDirectedLinks;
+    if (m_interferenceGraph.changeTrackingEnabled()) flags |= kFlagChangeTracking;
+    if (m_interferenceGraph.kineticLinks()) flags |= kFlagKineticLinks;
+    writePod(out, flags);
+    writePod(out, m_idmParams);
+    writePod(out, uint8_t(m_interferenceGraph.propagationModel()));
+    writePod(out, m_interferenceGraph.radioParams());
+    const KineticLinks* kinetic = m_interferenceGraph.kineticLinks();
+    writePod(out, kinetic ? kinetic->horizon() : 0.0);
+
+    // Générateur aléatoire (représentation textuelle standard de mt19937)
+    std::ostringstream rng;
+    rng << m_rng;
+    writeString(out, rng.str());
+
+    // Véhicules (les emplacements vides ne sont pas conservés)
+    std::vector<int32_t> slot(m_vehicles.size(), -1);
+    uint64_t count = 0;
+    for (size_t i = 0; i < m_vehicles.size(); ++i) {
+        if (m_vehicles[i]) slot[i] = int32_t(count++);
+    }
+    writePod(out, count);
+    for (const Vehicule* v : m_vehicles) {
+        if (v) writeVehicleState(out, v->saveState());
+    }
+
+    // Arrivées en attente (mode événementiel), indices renumérotés
+    auto pending = m_arrivals;
+    std::vector<ArrivalRecord> arrivals;
+    arrivals.reserve(pending.size());
+    for (; !pending.empty(); pending.pop()) {
+        const auto [t, i] = pending.top();
+        if (slot[i] >= 0) arrivals.push_back({t, slot[i]});
+    }
+    writeVector(out, arrivals);
 
+    return bool(out);
+}
 
+bool Simulator::readCheckpoint(std::istream& in, const std::string& path) {
+    char magic[sizeof(kCheckpointMagic)];
+    uint32_t version = 0;
+    uint64_t print = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kCheckpointMagic) ||
+        !readPod(in, version) || version != kCheckpointVersion) {
+        std::cerr << "Erreur : " << path << " n'est pas un checkpoint valide" << std::endl;
+        return false;
+    }
+    if (!readPod(in, print) || print != GraphBuilder::fingerprint(graph)) {
+        std::cerr << "Erreur : le checkpoint " << path << " a été créé pour un autre graphe" << std::endl;
+        return false;
+    }
 
+    // Lecture complète avant de toucher à l'état du simulateur
+    uint64_t tick = 0;
+    double simTime = 0.0, speedMultiplier = 1.0;
+    int32_t tickIntervalMs = 0;
+    uint8_t flags = 0;
+    IdmParams idm;
+    uint8_t model = 0;
+    RadioParams radio;
+    double horizon = 0.0;
+    std::string rngState;
+    uint64_t count = 0;
+    bool ok = readPod(in, tick) && readPod(in, simTime) && readPod(in, tickIntervalMs) &&
+              readPod(in, speedMultiplier) && readPod(in, flags) && readPod(in, idm) &&
+              readPod(in, model) && model <= uint8_t(PropagationModel::Shadowing) && readPod(in, radio) &&
+              radio.isValid() && readPod(in, horizon) && std::isfinite(horizon) && horizon >= 0.0 &&
+              readString(in, rngState, kMaxRngStateBytes) &&
+              readPod(in, count) && count <= kMaxCheckpointVehicles;
 
+    std::mt19937 rng;
+    if (ok) {
+        std::istringstream rngIn(rngState);
+        ok = bool(rngIn >> rng);
+    }
 
+    const size_t n = boost::num_vertices(graph);
+    std::vector<Vehicule::State> states(ok ? size_t(count) : 0);
+    for (auto& st : states) {
+        ok = ok && readVehicleState(in, st);
+        ok = ok && st.start < n && st.goal < n && st.currVertex < n && st.nextVertex < n &&
+             st.previousVertex < n && st.plannedNext < n &&
+             std::all_of(st.route.begin(), st.route.end(), [n](uint32_t v) { return v < n; });
+        if (!ok) break;
+    }
 
+    std::vector<ArrivalRecord> arrivals;
+    ok = ok && readVector(in, arrivals, count);
+    ok = ok && std::all_of(arrivals.begin(), arrivals.end(),
+                           [count](const ArrivalRecord& a) { return a.vehicle >= 0 && uint64_t(a.vehicle) < count; });
+    if (!ok) {
+        std::cerr << "Erreur : checkpoint " << path << " tronqué ou corrompu" << std::endl;
+        return false;
+    }
 
+    // Une trace décrit une exécution continue (ticks croissants) : elle s'arrête ici
+    if (m_trace.isOpen()) {
+        std::cerr << "Enregistrement arrêté par la restauration du checkpoint " << path << std::endl;
+        m_trace.close();
+    }
 
+    // Remplacement de l'état
+    for (Vehicule* v : m_vehicles) delete v;
+    m_vehicles.clear();
+    m_arrivals = {};
+    m_occupancy.clear();
 
+    m_tick = tick;
+    m_simTime = simTime;
+    m_tickIntervalMs = tickIntervalMs;
+    if (m_timer->isActive()) m_timer->setInterval(m_tickIntervalMs);   // en pause : repris par resume()
+    m_speedMultiplier.store(speedMultiplier);
+    m_collisionDetectionEnabled.store(flags & kFlagCollision);
+    m_carFollowingEnabled.store(flags & kFlagCarFollowing);
+    m_eventDriven = flags & kFlagEventDriven;
+    m_idmParams = idm;
+    m_interferenceGraph.setPropagationModel(PropagationModel(model), radio);
+    m_interferenceGraph.setDirectedLinksEnabled(flags & kFlagDirectedLinks);
+    m_interferenceGraph.setChangeTrackingEnabled(flags & kFlagChangeTracking);
+    m_interferenceGraph.setKineticLinksEnabled(flags & kFlagKineticLinks, horizon);
+    m_rng = rng;
 
+    m_vehicles.reserve(states.size());
+    for (const auto& st : states) {
+        Vehicule* v = new Vehicule(st.id, graph, st.start, st.goal, st.speed, st.transmissionRange, st.collisionDist);
+        v->setRandomEngine(&m_rng);
+        if (st.followsRoute) v->setRoutePlanner(m_routePlanner);
+        v->restoreState(st, m_eventDriven ? &m_simTime : nullptr);
+        m_vehicles.push_back(v);
+    }
+    for (const auto& a : arrivals) m_arrivals.push({a.time, a.vehicle});
+
+    // Structures dérivées des positions
+    m_occupancy.update(m_vehicles);
+    m_interferenceGraph.buildGraph(m_vehicles);
+    publishSnapshot();
+    m_elapsed.restart();   // le temps passé à restaurer ne compte pas comme temps simulé
+    return true;
+}
@@ -0,0 +1,302 @@
+#include "sinr_model.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace {
+double dbmToMw(double dbm) { return std::pow(10.0, dbm / 10.0); }
+
+constexpr int kGainOctaves = 128;   // d² jusqu'à 2^128 m², au-delà le dernier pas
+}
+
+SinrModel::SinrModel(const RadioParams& radio, const SinrParams& params)
+    : m_radio(radio),
+      m_params(params),
+      m_txPower(dbmToMw(radio.txPowerDbm)),
+      m_noise(dbmToMw(params.noiseDbm)),
+      m_threshold(std::pow(10.0, params.thresholdDb / 10.0)),
+      m_refGain(std::pow(10.0, -radio.referenceLossDb / 10.0)) {
+    // d² = m 2^e (m dans [0,5 ; 1), e >= 1 car d >= 1 m) : gain au milieu de chaque pas de m
+    m_gainTable.resize(size_t(kGainOctaves) * kGainSteps);
+    for (int e = 1; e <= kGainOctaves; ++e) {
+        for (int j = 0; j < kGainSteps; ++j) {
+            const double d2 = std::ldexp(0.5 + (j + 0.5) / (2.0 * kGainSteps), e);
+            m_gainTable[size_t(e - 1) * kGainSteps + j] = float(m_refGain * std::pow(d2, -0.5 * radio.exponent));
+        }
+    }
+}
+
+void SinrModel::bind(const InterferenceGraph::Generation& gen) {
+    if (m_gen == &gen && m_epoch == gen.epoch()) return;
+
+    // Tampons indexés par la génération
+    const int n = gen.vehicleCount();
+    m_txStamp.assign(n, 0);
+    m_txRank.assign(n, 0);
+    m_rxStamp.assign(n, 0);
+    m_rxPower.assign(n, 0.0);
+    m_slot = 0;
+    m_gen = &gen;
+    m_epoch = gen.epoch();
+}
+
+double SinrModel::gain(double dx, double dy) const {
+    // PL(d) = PL(1 m) + 10 n log10(d), d >= 1 m
+    const double d2 = std::max(1.0, dx * dx + dy * dy);
+    return m_refGain * std::pow(d2, -0.5 * m_radio.exponent);
+}
+
+double SinrModel::farGain(double dx, double dy) const {
+    int e;
+    const double m = std::frexp(std::max(1.0, dx * dx + dy * dy), &e);
+    const int octave = std::min(e, kGainOctaves) - 1;
+    const int step = std::min(int((m - 0.5) * (2 * kGainSteps)), kGainSteps - 1);
+    return m_gainTable[size_t(octave) * kGainSteps + step];
+}
+
+int64_t SinrModel::cellCoord(double v) const {
+    return int64_t(std::floor(v / m_params.cellSize));
+}
+
+bool SinrModel::isNear(const Cell& cell, int64_t cx, int64_t cy, int level) const {
+    // cx, cy : cellule de niveau 0 ; son ancêtre au niveau level par décalage (division par défaut)
+    return std::abs(cell.cx - (cx >> level)) <= m_params.nearCells &&
+           std::abs(cell.cy - (cy >> level)) <= m_params.nearCells;
+}
+
+void SinrModel::buildLevels() {
+    // Regroupe 2 x 2 cellules jusqu'à ce qu'elles soient toutes voisines les unes des autres
+    m_topLevel = 0;
+    while (m_topLevel + 1 < kMaxLevels) {
+        const std::vector<Cell>& cells = m_levels[m_topLevel].cells;
+        int64_t minX = INT64_MAX, maxX = INT64_MIN, minY = INT64_MAX, maxY = INT64_MIN;
+        for (const Cell& c : cells) {
+            minX = std::min(minX, c.cx);
+            maxX = std::max(maxX, c.cx);
+            minY = std::min(minY, c.cy);
+            maxY = std::max(maxY, c.cy);
+        }
+        if (cells.size() <= 1 || (maxX - minX <= m_params.nearCells && maxY - minY <= m_params.nearCells)) {
+            break;
+        }
+
+        if (int(m_levels.size()) <= m_topLevel + 1) m_levels.emplace_back();
+        Level& up = m_levels[m_topLevel + 1];
+        const Level& down = m_levels[m_topLevel];
+        up.cells.clear();
+        up.index.clear();
+        for (const Cell& c : down.cells) {
+            auto [it, inserted] = up.index.emplace(cellKey(c.cx >> 1, c.cy >> 1), int(up.cells.size()));
+            if (inserted) {
+                Cell parent;
+                parent.cx = c.cx >> 1;
+                parent.cy = c.cy >> 1;
+                up.cells.push_back(parent);
+            }
+            Cell& parent = up.cells[it->second];
+            parent.power += c.power;
+            parent.x += c.power * c.x;
+            parent.y += c.power * c.y;
+        }
+        for (Cell& parent : up.cells) {
+            parent.x /= parent.power;
+            parent.y /= parent.power;
+        }
+        ++m_topLevel;
+    }
+}
+
+const SinrModel::Cell& SinrModel::farAggregate(const Cell& own, int64_t cx, int64_t cy) const {
+    // Premier niveau où l'ancêtre de la cellule est hors du voisinage et sa parente dedans
+    int64_t ox = own.cx, oy = own.cy;
+    int level = 0;
+    while (level < m_topLevel && !isNear(Cell{ox >> 1, oy >> 1}, cx, cy, level + 1)) {
+        ox >>= 1;
+        oy >>= 1;
+        ++level;
+    }
+    return m_levels[level].cells[m_levels[level].index.at(cellKey(ox, oy))];
+}
+
+double SinrModel::farPower(int64_t cx, int64_t cy) {
+    const uint64_t key = cellKey(cx, cy);
+    auto it = m_farCache.find(key);
+    if (it != m_farCache.end()) return it->second;
+
+    // Vu du centre de la cellule du récepteur : chaque cellule lointaine à son barycentre
+    const double x = (cx + 0.5) * m_params.cellSize;
+    const double y = (cy + 0.5) * m_params.cellSize;
+    const int k = m_params.nearCells;
+    double sum = 0.0;
+    for (int level = 0; level <= m_topLevel; ++level) {
+        const Level& lv = m_levels[level];
+        if (level == m_topLevel) {
+            // Dernier niveau : toutes les cellules hors voisinage
+            for (const Cell& cell : lv.cells) {
+                if (!isNear(cell, cx, cy, level)) sum += cell.power * farGain(x - cell.x, y - cell.y);
+            }
+            break;
+        }
+
+        // Liste d'interaction : enfants du voisinage de la parente, hors voisinage de la cellule
+        const int64_t px = cx >> (level + 1);
+        const int64_t py = cy >> (level + 1);
+        for (int64_t i = 2 * (px - k); i <= 2 * (px + k) + 1; ++i) {
+            for (int64_t j = 2 * (py - k); j <= 2 * (py + k) + 1; ++j) {
+                auto found = lv.index.find(cellKey(i, j));
+                if (found == lv.index.end()) continue;
+
+                const Cell& cell = lv.cells[found->second];
+                if (!isNear(cell, cx, cy, level)) sum += cell.power * farGain(x - cell.x, y - cell.y);
+            }
+        }
+    }
+    m_farCache.emplace(key, sum);
+    return sum;
+}
+
+double SinrModel::receivedPower(int receiver) {
+    if (m_rxStamp[receiver] == m_slot) return m_rxPower[receiver];
+
+    const double x = m_gen->xAt(receiver);
+    const double y = m_gen->yAt(receiver);
+    const int64_t cx = cellCoord(x);
+    const int64_t cy = cellCoord(y);
+    const int k = m_params.nearCells;
+    const Level& base = m_levels[0];
+
+    double sum = 0.0;
+    for (int64_t i = cx - k; i <= cx + k; ++i) {
+        for (int64_t j = cy - k; j <= cy + k; ++j) {
+            auto it = base.index.find(cellKey(i, j));
+            if (it == base.index.end()) continue;
+
+            const Cell& cell = base.cells[it->second];
+            for (int m = cell.begin; m < cell.end; ++m) {
+                const int t = m_cellMembers[m];
+                sum += m_txPower * gain(x - m_gen->xAt(t), y - m_gen->yAt(t));
+            }
+        }
+    }
+    sum += farPower(cx, cy);
+
+    m_rxStamp[receiver] = m_slot;
+    m_rxPower[receiver] = sum;
+    return sum;
+}
+
+double SinrModel::interference(int receiver, int transmitter, double signal) {
+    const double total = receivedPower(receiver);
+
+    // Part de l'émetteur utile dans le total : exacte s'il est proche, sinon telle
+    // qu'elle a été comptée, au barycentre de la cellule qui l'agrège
+    const int64_t cx = cellCoord(m_gen->xAt(receiver));
+    const int64_t cy = cellCoord(m_gen->yAt(receiver));
+    const Cell& own = m_levels[0].cells[m_cellOfTx[m_txRank[transmitter]]];
+    double share = signal;
+    if (!isNear(own, cx, cy)) {
+        const Cell& agg = farAggregate(own, cx, cy);
+        share = m_txPower * farGain((cx + 0.5) * m_params.cellSize - agg.x, (cy + 0.5) * m_params.cellSize - agg.y);
+    }
+    return std::max(0.0, total - share);
+}
+
+SinrModel::Stats SinrModel::evaluate(const InterferenceGraph::Generation& gen,
+                                     const std::vector<int>& transmitterIds,
+                                     std::vector<std::pair<int, int>>& usable) {
+    Stats stats;
+    usable.clear();
+    bind(gen);
+
+    if (++m_slot == 0) {
+        std::fill(m_txStamp.begin(), m_txStamp.end(), 0);
+        std::fill(m_rxStamp.begin(), m_rxStamp.end(), 0);
+        m_slot = 1;
+    }
+
+    // Émetteurs actifs (indices denses, sans doublon)
+    m_transmitters.clear();
+    for (int id : transmitterIds) {
+        const int i = gen.indexOf(id);
+        if (i >= 0 && m_txStamp[i] != m_slot) {
+            m_txStamp[i] = m_slot;
+            m_txRank[i] = int(m_transmitters.size());
+            m_transmitters.push_back(i);
+        }
+    }
+
+    // Cellules occupées : puissance totale, barycentre et membres (CSR)
+    if (m_levels.empty()) m_levels.emplace_back();
+    std::vector<Cell>& cells = m_levels[0].cells;
+    std::unordered_map<uint64_t, int>& cellOf = m_levels[0].index;
+    cells.clear();
+    cellOf.clear();
+    m_farCache.clear();
+    m_cellOfTx.resize(m_transmitters.size());
+    for (size_t k = 0; k < m_transmitters.size(); ++k) {
+        const int t = m_transmitters[k];
+        const int64_t cx = cellCoord(gen.xAt(t));
+        const int64_t cy = cellCoord(gen.yAt(t));
+        auto [it, inserted] = cellOf.emplace(cellKey(cx, cy), int(cells.size()));
+        if (inserted) {
+            Cell cell;
+            cell.cx = cx;
+            cell.cy = cy;
+            cells.push_back(cell);
+        }
+        Cell& cell = cells[it->second];
+        cell.power += m_txPower;
+        cell.x += m_txPower * gen.xAt(t);
+        cell.y += m_txPower * gen.yAt(t);
+        cell.end++;
+        m_cellOfTx[k] = it->second;
+    }
+
+    int offset = 0;
+    for (Cell& cell : cells) {
+        cell.x /= cell.power;
+        cell.y /= cell.power;
+        cell.begin = offset;
+        offset += cell.end;
+        cell.end = cell.begin;
+    }
+    m_cellMembers.resize(m_transmitters.size());
+    for (size_t k = 0; k < m_transmitters.size(); ++k) {
+        m_cellMembers[cells[m_cellOfTx[k]].end++] = m_transmitters[k];
+    }
+    buildLevels();
+
+    // Liens candidats : voisins directs de chaque émetteur
+    for (int t : m_transmitters) {
+        for (const int* it = gen.neighborsBegin(t); it != gen.neighborsEnd(t); ++it) {
+            const int r = *it;
+            ++stats.candidates;
+            if (m_txStamp[r] == m_slot) {
+                ++stats.halfDuplex;
+                continue;
+            }
+
+            const double signal = m_txPower * gain(gen.xAt(r) - gen.xAt(t), gen.yAt(r) - gen.yAt(t));
+            const double sinr = signal / (m_noise + interference(r, t, signal));
+            if (sinr >= m_threshold) {
+                ++stats.usable;
+                stats.sumSinrDb += 10.0 * std::log10(sinr);
+                usable.push_back({gen.idAt(t), gen.idAt(r)});
+            }
+        }
+    }
+
+    return stats;
+}
+
+double SinrModel::exactSinrDb(const InterferenceGraph::Generation& gen, int transmitterId, int receiverId) const {
+    const int t = gen.indexOf(transmitterId);
+    const int r = gen.indexOf(receiverId);
+    if (t < 0 || r < 0 || m_gen != &gen || m_epoch != gen.epoch()) return -INFINITY;
+
+    double noise = m_noise;
+    for (int other : m_transmitters) {
+        if (other != t) noise += m_txPower * gain(gen.xAt(r) - gen.xAt(other), gen.yAt(r) - gen.yAt(other));
+    }
+    return 10.0 * std::log10(m_txPower * gain(gen.xAt(r) - gen.xAt(t), gen.yAt(r) - gen.yAt(t)) / noise);
+}
@@ -0,0 +1,354 @@
+#include "trajectory_trace.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr char kTraceMagic[8] = {'V', '2', 'V', 'T', 'R', 'A', 'C', 'E'};
+constexpr char kIndexMagic[8] = {'V', '2', 'V', 'T', 'I', 'D', 'X', 0};
+constexpr uint32_t kTraceVersion = 2;
+
+constexpr uint64_t kHeaderBytes = sizeof(kTraceMagic) + 2 * sizeof(uint32_t) + sizeof(uint8_t) + sizeof(RadioParams);
+constexpr uint64_t kChunkHeaderBytes = 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+constexpr uint64_t kIndexEntryBytes = 3 * sizeof(uint64_t);
+constexpr uint64_t kFooterBytes = 2 * sizeof(uint64_t) + sizeof(kIndexMagic);
+
+// Quantification : 1e-7 degré (~1 cm) pour les positions, 1 cm pour la portée
+constexpr double kDegreeScale = 1e7;
+constexpr double kRangeScale = 100.0;
+constexpr int kFields = 4;      // id, lat, lon, portée
+
+void putVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(char(uint8_t(v) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(char(v));
+}
+
+void putZigzag(std::string& out, int64_t v) {
+    putVarint(out, (uint64_t(v) << 1) ^ uint64_t(v >> 63));
+}
+
+template <typename T>
+void putRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Lecture bornée dans la zone projetée ; pos avance, false si on dépasse end
+bool getVarint(const uchar* data, uint64_t& pos, uint64_t end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        const uchar b = data[pos++];
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool getZigzag(const uchar* data, uint64_t& pos, uint64_t end, int64_t& v) {
+    uint64_t u;
+    if (!getVarint(data, pos, end, u)) return false;
+    v = int64_t(u >> 1) ^ -int64_t(u & 1);
+    return true;
+}
+
+template <typename T>
+bool getRaw(const uchar* data, uint64_t& pos, uint64_t end, T& value) {
+    if (end - pos < sizeof(T)) return false;
+    std::memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// TraceWriter
+// ---------------------------------------------------------------------------
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+bool TraceWriter::open(const std::string& path, uint32_t chunkFrames, PropagationModel model,
+                       const RadioParams& radio) {
+    close();
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out) {
+        std::cerr << "Erreur : impossible de créer la trace " << path << std::endl;
+        return false;
+    }
+    m_path = path;
+    m_chunkFrames = std::max<uint32_t>(chunkFrames, 1);
+    m_chunk.clear();
+    m_chunkFrameCount = 0;
+    m_index.clear();
+
+    m_out.write(kTraceMagic, sizeof(kTraceMagic));
+    writePod(m_out, kTraceVersion);
+    writePod(m_out, m_chunkFrames);
+    writePod(m_out, uint8_t(model));
+    writePod(m_out, radio);
+    return bool(m_out);
+}
+
+bool TraceWriter::append(const SimulationSnapshot& snap) {
+    if (!isOpen()) return false;
+
+    // Les écarts de tick et la recherche dans l'index supposent des ticks croissants
+    if ((m_chunkFrameCount > 0 || !m_index.empty()) && snap.tick <= m_lastTick) {
+        std::cerr << "Erreur : tick " << snap.tick << " non croissant dans la trace " << m_path << std::endl;
+        return false;
+    }
+
+    if (m_chunkFrameCount == 0) {
+        // Début de bloc : référence à zéro, décodable sans le bloc précédent
+        m_chunkFirstTick = snap.tick;
+        m_lastTick = snap.tick;
+        m_prev.clear();
+    }
+
+    putVarint(m_chunk, snap.tick - m_lastTick);
+    putRaw(m_chunk, snap.simTime);
+    putVarint(m_chunk, snap.vehicles.size());
+
+    const size_t n = snap.vehicles.size();
+    if (m_prev.size() < n * kFields) m_prev.resize(n * kFields, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const VehicleState& v = snap.vehicles[i];
+        const int64_t q[kFields] = {
+            v.id,
+            std::llround(v.lat * kDegreeScale),
+            std::llround(v.lon * kDegreeScale),
+            std::llround(v.range * kRangeScale),
+        };
+        int64_t* prev = m_prev.data() + i * kFields;
+        for (int f = 0; f < kFields; ++f) {
+            putZigzag(m_chunk, q[f] - prev[f]);
+            prev[f] = q[f];
+        }
+    }
+    m_prev.resize(n * kFields);
+
+    m_lastTick = snap.tick;
+    if (++m_chunkFrameCount >= m_chunkFrames) return flushChunk();
+    return true;
+}
+
+bool TraceWriter::flushChunk() {
+    if (m_chunkFrameCount == 0) return true;
+
+    m_index.push_back({m_chunkFirstTick, m_lastTick, uint64_t(m_out.tellp())});
+    writePod(m_out, m_chunkFrameCount);
+    writePod(m_out, uint32_t(m_chunk.size()));
+    writePod(m_out, m_chunkFirstTick);
+    writePod(m_out, m_lastTick);
+    m_out.write(m_chunk.data(), std::streamsize(m_chunk.size()));
+    m_out.flush();   // une trace interrompue reste lisible jusqu'au dernier bloc complet
+
+    m_chunk.clear();
+    m_chunkFrameCount = 0;
+    if (!m_out) {
+        std::cerr << "Erreur : écriture de la trace " << m_path << " interrompue" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TraceWriter::close() {
+    if (!isOpen()) return true;
+    bool ok = flushChunk();
+
+    const uint64_t indexOffset = uint64_t(m_out.tellp());
+    for (const auto& e : m_index) {
+        writePod(m_out, e.firstTick);
+        writePod(m_out, e.lastTick);
+        writePod(m_out, e.offset);
+    }
+    writePod(m_out, indexOffset);
+    writePod(m_out, uint64_t(m_index.size()));
+    m_out.write(kIndexMagic, sizeof(kIndexMagic));
+
+    ok = ok && bool(m_out);
+    if (!ok) std::cerr << "Erreur : index de la trace " << m_path << " non écrit" << std::endl;
+    m_out.close();
+    m_index.clear();
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// TraceReader
+// ---------------------------------------------------------------------------
+
+TraceReader::~TraceReader() {
+    close();
+}
+
+bool TraceReader::open(const QString& path) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        std::cerr << "Erreur : impossible d'ouvrir la trace " << path.toStdString() << std::endl;
+        return false;
+    }
+    m_size = uint64_t(m_file.size());
+    m_data = m_size >= kHeaderBytes ? m_file.map(0, m_file.size()) : nullptr;
+    if (!m_data) {
+        std::cerr << "Erreur : impossible de projeter la trace " << path.toStdString() << std::endl;
+        close();
+        return false;
+    }
+
+    uint64_t pos = sizeof(kTraceMagic);
+    uint32_t version = 0, chunkFrames = 0;
+    uint8_t model = 0;
+    if (std::memcmp(m_data, kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+        !getRaw(m_data, pos, m_size, version) || version != kTraceVersion ||
+        !getRaw(m_data, pos, m_size, chunkFrames) || !getRaw(m_data, pos, m_size, model) ||
+        model > uint8_t(PropagationModel::Shadowing) || !getRaw(m_data, pos, m_size, m_radio) ||
+        !m_radio.isValid()) {
+        std::cerr << "Erreur : " << path.toStdString() << " n'est pas une trace valide" << std::endl;
+        close();
+        return false;
+    }
+    m_model = PropagationModel(model);
+
+    // Index en fin de fichier ; à défaut (trace interrompue), parcours des blocs
+    if (!loadIndex() && !scanChunks()) {
+        std::cerr << "Erreur : trace " << path.toStdString() << " illisible" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TraceReader::close() {
+    if (m_data) m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+    if (m_file.isOpen()) m_file.close();
+    m_chunks.clear();
+    m_cursorChunk = -1;
+}
+
+bool TraceReader::readChunkHeader(uint64_t offset, Chunk& chunk) const {
+    if (offset > m_size) return false;
+    uint64_t pos = offset;
+    chunk.offset = offset;
+    return getRaw(m_data, pos, m_size, chunk.frameCount) &&
+           getRaw(m_data, pos, m_size, chunk.payloadBytes) &&
+           getRaw(m_data, pos, m_size, chunk.firstTick) &&
+           getRaw(m_data, pos, m_size, chunk.lastTick) &&
+           m_size - pos >= chunk.payloadBytes && chunk.frameCount > 0;
+}
+
+bool TraceReader::loadIndex() {
+    if (m_size < kHeaderBytes + kFooterBytes) return false;
+    uint64_t pos = m_size - kFooterBytes;
+    uint64_t indexOffset = 0, count = 0;
+    getRaw(m_data, pos, m_size, indexOffset);
+    getRaw(m_data, pos, m_size, count);
+    if (std::memcmp(m_data + pos, kIndexMagic, sizeof(kIndexMagic)) != 0) return false;
+    if (indexOffset < kHeaderBytes || indexOffset + count * kIndexEntryBytes != m_size - kFooterBytes) return false;
+
+    std::vector<Chunk> chunks(count);
+    pos = indexOffset;
+    for (auto& c : chunks) {
+        uint64_t firstTick, lastTick, offset;
+        getRaw(m_data, pos, m_size, firstTick);
+        getRaw(m_data, pos, m_size, lastTick);
+        getRaw(m_data, pos, m_size, offset);
+        if (!readChunkHeader(offset, c) || c.firstTick != firstTick || c.lastTick != lastTick) return false;
+    }
+    m_chunks = std::move(chunks);
+    return true;
+}
+
+bool TraceReader::scanChunks() {
+    m_chunks.clear();
+    Chunk c;
+    uint64_t offset = kHeaderBytes;
+    while (readChunkHeader(offset, c)) {
+        m_chunks.push_back(c);
+        offset += kChunkHeaderBytes + c.payloadBytes;
+    }
+    return true;   // éventuellement vide : rien d'enregistré avant l'interruption
+}
+
+bool TraceReader::decodeNextFrame() {
+    const Chunk& c = m_chunks[m_cursorChunk];
+    const uint64_t end = c.offset + kChunkHeaderBytes + c.payloadBytes;
+    if (m_cursorFramesRead >= c.frameCount) return false;
+
+    uint64_t dt, count;
+    double simTime;
+    if (!getVarint(m_data, m_cursorPos, end, dt) || !getRaw(m_data, m_cursorPos, end, simTime) ||
+        !getVarint(m_data, m_cursorPos, end, count) || count > end - m_cursorPos) {
+        return false;
+    }
+
+    SimulationSnapshot& f = m_cursorFrame;
+    f.tick = (m_cursorFramesRead == 0 ? c.firstTick : f.tick) + dt;
+    f.simTime = simTime;
+    f.vehicles.resize(size_t(count));
+    if (m_cursorPrev.size() < count * kFields) m_cursorPrev.resize(size_t(count) * kFields, 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        int64_t* prev = m_cursorPrev.data() + i * kFields;
+        for (int k = 0; k < kFields; ++k) {
+            int64_t d;
+            if (!getZigzag(m_data, m_cursorPos, end, d)) return false;
+            prev[k] += d;
+        }
+        f.vehicles[i] = {int(prev[0]), double(prev[1]) / kDegreeScale, double(prev[2]) / kDegreeScale,
+                         double(prev[3]) / kRangeScale};
+    }
+    m_cursorPrev.resize(size_t(count) * kFields);
+    ++m_cursorFramesRead;
+    return true;
+}
+
+bool TraceReader::readFrame(uint64_t tick, SimulationSnapshot& out) {
+    if (!isOpen() || m_chunks.empty() || tick < m_chunks.front().firstTick) return false;
+
+    // Dernier bloc commençant au plus tard à tick
+    auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), tick,
+                               [](uint64_t t, const Chunk& c) { return t < c.firstTick; });
+    const int chunk = int(it - m_chunks.begin()) - 1;
+
+    // Reprise du curseur si possible, sinon décodage depuis la première frame du bloc
+    const bool resume = chunk == m_cursorChunk && m_cursorFramesRead > 0 && m_cursorFrame.tick <= tick;
+    if (!resume) {
+        m_cursorChunk = chunk;
+        m_cursorFramesRead = 0;
+        m_cursorPos = m_chunks[chunk].offset + kChunkHeaderBytes;
+        m_cursorPrev.clear();
+        if (!decodeNextFrame()) {
+            m_cursorChunk = -1;
+            return false;
+        }
+    }
+
+    // Avance tant que la frame suivante ne dépasse pas tick (écart de tick lu sans décoder)
+    const Chunk& c = m_chunks[chunk];
+    const uint64_t end = c.offset + kChunkHeaderBytes + c.payloadBytes;
+    while (m_cursorFramesRead < c.frameCount && m_cursorFrame.tick < tick) {
+        uint64_t pos = m_cursorPos, dt;
+        if (!getVarint(m_data, pos, end, dt) || m_cursorFrame.tick + dt > tick) break;
+        if (!decodeNextFrame()) {
+            m_cursorChunk = -1;
+            return false;
+        }
+    }
+
+    out.tick = m_cursorFrame.tick;
+    out.simTime = m_cursorFrame.simTime;
+    out.vehicles = m_cursorFrame.vehicles;
+    out.links.clear();
+    out.component.clear();
+    return true;
+}
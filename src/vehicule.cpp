@@ -1,5 +1,7 @@
 #include "vehicule.h"
 #include "graph_builder.h"
+#include <limits>
+#include <algorithm>
 
 //Constructor
 Vehicule::Vehicule(int id, const RoadGraph& graph, Vertex start, Vertex goal, double speed, double range, double collisionDist)
@@ -7,10 +9,11 @@ Vehicule::Vehicule(int id, const RoadGraph& graph, Vertex start, Vertex goal, do
     graph(graph),
     start(start),
     goal(goal),
-    currVertex(start),
+    collisionDist(collisionDist),
     transmissionRange(range),
     speed(speed),
-    collisionDist(collisionDist)
+    desiredSpeed(speed),
+    currVertex(start)
 {}
 
 
@@ -53,8 +56,8 @@ void Vehicule::DestReached() {
     edgeLength = 0.0;
 }
 
-Vertex Vehicule::pickNextEdge() {
-    auto [itStart, itEnd] = boost::out_edges(currVertex, graph);
+bool Vehicule::chooseOutEdge(Vertex at, Vertex from, Edge& chosen) const {
+    auto [itStart, itEnd] = boost::out_edges(at, graph);
 
     std::vector<Edge> validEdges;
     Edge backEdge = Edge();   // placeholder for the edge going back to previous vertex
@@ -66,7 +69,7 @@ Vertex Vehicule::pickNextEdge() {
 
         if (!isValidRoad(graph[e].type)) continue;
 
-        if (target == previousVertex) {
+        if (target == from) {
             // remember this edge in case we have no other choice
             backEdge = e;
             hasBackEdge = true;
@@ -76,19 +79,87 @@ Vertex Vehicule::pickNextEdge() {
     }
 
     if (validEdges.empty()) {
-        if (hasBackEdge) {
-            validEdges.push_back(backEdge); // only option is to go back
-        } else {
-            // truly stuck: swap start/goal
-            std::swap(start, goal);
-            nextVertex = start;
-            edgeLength = 0.0;
-            return nextVertex;
-        }
+        if (!hasBackEdge) return false;
+        validEdges.push_back(backEdge); // only option is to go back
     }
 
     // pick random valid edge (avoiding immediate backtracking if possible)
-    currEdge = validEdges[rand() % validEdges.size()];
+    const size_t k = rng ? std::uniform_int_distribution<size_t>(0, validEdges.size() - 1)(*rng)
+                         : size_t(rand()) % validEdges.size();
+    chosen = validEdges[k];
+    return true;
+}
+
+bool Vehicule::routeValid() const {
+    return route && routeIndex < route->size() && route->back() == goal;
+}
+
+bool Vehicule::followRoute(Edge& chosen) {
+    if (!planner) return false;
+
+    // (re)plan when there is no route, after a detour, or once the goal has changed
+    if (!routeValid() || (*route)[routeIndex] != currVertex) {
+        route = planner->route(currVertex, goal);
+        routeIndex = 0;
+        if (!route) return false;
+    }
+    if (routeIndex + 1 >= route->size()) return false;
+
+    auto [e, exists] = boost::edge(currVertex, (*route)[routeIndex + 1], graph);
+    if (!exists) {
+        route.reset();
+        return false;
+    }
+    chosen = e;
+    ++routeIndex;
+    return true;
+}
+
+Vertex Vehicule::peekNextVertex() {
+    if (!isOnEdge()) return nextVertex;
+
+    // on a route, the next hop is already known
+    if (routeValid() && (*route)[routeIndex] == nextVertex) {
+        return routeIndex + 1 < route->size() ? (*route)[routeIndex + 1] : nextVertex;
+    }
+
+    // Decide the hop after nextVertex now, so followers can look one edge ahead;
+    // pickNextEdge will honour this choice when the vehicle gets there
+    if (!hasPlannedNext) {
+        Edge e;
+        if (nextVertex == goal || !chooseOutEdge(nextVertex, currVertex, e)) return nextVertex;
+        plannedNext = boost::target(e, graph);
+        hasPlannedNext = true;
+    }
+    return plannedNext;
+}
+
+Vertex Vehicule::pickNextEdge() {
+    Edge chosen;
+    bool found = followRoute(chosen);   // shortest path to goal when a planner is set
+
+    // follow the hop announced by peekNextVertex, if any
+    if (found) {
+        hasPlannedNext = false;
+    } else if (hasPlannedNext) {
+        hasPlannedNext = false;
+        auto [e, exists] = boost::edge(currVertex, plannedNext, graph);
+        if (exists) {
+            chosen = e;
+            found = true;
+        }
+    }
+    if (!found) found = chooseOutEdge(currVertex, previousVertex, chosen);
+
+    if (!found) {
+        // truly stuck: swap start/goal
+        std::swap(start, goal);
+        nextVertex = start;
+        edgeLength = 0.0;
+        return nextVertex;
+    }
+
+    currEdge = chosen;
     previousVertex = currVertex;  // remember current as previous
     nextVertex = boost::target(currEdge, graph);
     edgeLength = graph[currEdge].distance;
@@ -130,6 +201,90 @@ void Vehicule::update(double deltaTime) {
 
 
 
+Vehicule::State Vehicule::saveState() const {
+    State s;
+    s.id = id;
+    s.start = uint32_t(start);
+    s.goal = uint32_t(goal);
+    s.currVertex = uint32_t(currVertex);
+    s.nextVertex = uint32_t(nextVertex);
+    s.previousVertex = uint32_t(previousVertex);
+    s.plannedNext = uint32_t(plannedNext);
+    s.speed = speed;
+    s.desiredSpeed = desiredSpeed;
+    s.transmissionRange = transmissionRange;
+    s.collisionDist = collisionDist;
+    s.positionOnEdge = positionOnEdge;
+    s.edgeLength = edgeLength;
+    s.edgeEntryTime = edgeEntryTime;
+    s.hasPlannedNext = hasPlannedNext;
+    s.destReached = destReached;
+    s.followsRoute = planner != nullptr;
+    if (routeValid()) s.route.assign(route->begin() + routeIndex, route->end());
+    return s;
+}
+
+void Vehicule::restoreState(const State& s, const double* clock) {
+    start = s.start;
+    goal = s.goal;
+    currVertex = s.currVertex;
+    nextVertex = s.nextVertex;
+    previousVertex = s.previousVertex;
+    plannedNext = s.plannedNext;
+    speed = s.speed;
+    desiredSpeed = s.desiredSpeed;
+    transmissionRange = s.transmissionRange;
+    collisionDist = s.collisionDist;
+    positionOnEdge = s.positionOnEdge;
+    edgeLength = s.edgeLength;
+    edgeEntryTime = s.edgeEntryTime;
+    hasPlannedNext = s.hasPlannedNext;
+    destReached = s.destReached;
+    lazyClock = clock;
+
+    // currEdge is only needed on an edge (getPosition)
+    if (edgeLength > 0.0) currEdge = boost::edge(currVertex, nextVertex, graph).first;
+
+    route.reset();
+    routeIndex = 0;
+    if (!s.route.empty()) route = std::make_shared<const std::vector<Vertex>>(s.route.begin(), s.route.end());
+}
+
+void Vehicule::setLazyClock(const double* clock) {
+    if (lazyClock) positionOnEdge = lazyPositionOnEdge();  // materialize before switching
+    lazyClock = clock;
+    if (lazyClock) edgeEntryTime = *lazyClock;
+}
+
+double Vehicule::lazyPositionOnEdge() const {
+    const double pos = positionOnEdge + speed * (*lazyClock - edgeEntryTime);
+    return std::min(pos, edgeLength);
+}
+
+double Vehicule::nextArrivalTime() const {
+    if (edgeLength <= 0.0) return edgeEntryTime;   // at a vertex: leaves immediately
+    if (speed <= 0.0) return std::numeric_limits<double>::infinity();
+    return edgeEntryTime + (edgeLength - positionOnEdge) / speed;
+}
+
+void Vehicule::arriveAt(double eventTime) {
+    // same transitions as update(), without a per-tick position integration
+    bool picked = false;
+    if (edgeLength > 0.0) {
+        previousVertex = currVertex;  // remember where we came from
+        currVertex = nextVertex;
+        if (currVertex == goal) {
+            DestReached();
+        } else {
+            pickNextEdge();
+            picked = true;
+        }
+    }
+    if (!picked && edgeLength <= 0.0) pickNextEdge();
+    positionOnEdge = 0.0;
+    edgeEntryTime = eventTime;
+}
+
 std::pair<double,double> Vehicule::getPosition() const {
     if (edgeLength <= 0.0) {
         const auto& vd = graph[currVertex];
@@ -141,7 +296,7 @@ std::pair<double,double> Vehicule::getPosition() const {
     const auto& sd = graph[s];
     const auto& td = graph[t];
 
-    double tparam = positionOnEdge / edgeLength;
+    double tparam = getPositionOnEdge() / edgeLength;
     if (tparam < 0) tparam = 0;
     if (tparam > 1) tparam = 1;
 
@@ -150,7 +305,7 @@ std::pair<double,double> Vehicule::getPosition() const {
     return {lat, lon};
 }
 
-double Vehicule::calculateDist(Vehicule from) const{
+double Vehicule::calculateDist(const Vehicule& from) const{
     auto [lat1, lon1] = getPosition();
     auto [lat2, lon2] = from.getPosition();
 
@@ -158,11 +313,11 @@ double Vehicule::calculateDist(Vehicule from) const{
 
 }
 
-void Vehicule::avoidCollision() {
-    for (Vehicule* v : neighbors) {
-        double dist = calculateDist(*v);
-        if (dist <= collisionDist) {
-            speed *= slowFactor;
-        }
+void Vehicule::avoidCollision(double gapToLeader) {
+    if (gapToLeader <= collisionDist) {
+        speed *= slowFactor;
+    } else if (speed < desiredSpeed) {
+        // gap reopened: win back part of the lost speed each tick (also from a standstill)
+        speed = std::min(desiredSpeed, speed + (desiredSpeed - speed) * (1.0 - slowFactor));
     }
 }